@@ -10,18 +10,21 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include "cparserpaths.h"
 #include "cparsertools.h"
 #include "cparsertoken.h"
+#include "cparserkeyword.h"
+#include "cparseratom.h"
+#include "cparsertokenstream.h"
+#include "cparserlines.h"
+#include "cparserfile.h"
 #include "cparserobject.h"
 #include "cparserdictionary.h"
 #include "cparserstack.h"
 #include "cparserexpression.h"
 #include "cparser.h"
 
-#define KEYWORDS_C_COUNT				34
-#define KEYWORDS_PREPROCESSOR_COUNT		13
-
 #define DATATYPE_DEFINED_FLAGS  		(\
 										EFLAGS_MODIFIER_SIGNED 		       	|\
 										EFLAGS_MODIFIER_UNSIGNED 	      	|\
@@ -36,6 +39,9 @@
 										EFLAGS_USER_DEFINED_DATATYPE		 \
 										)
 
+#define DEFINES_VALUE_NONE				UINT32_MAX		// Loaded definition without value object
+
+
 
 typedef enum states_e
 {
@@ -75,10 +81,27 @@ typedef enum conditional_compilation_state_s
 	CONDITIONAL_COMPILATION_STATE_ACCEPTING_ELSE	// Accepting tokens untiel #endif
 } conditional_compilation_state_t;
 
+// Parser instance, definitions are shared with the caller
+struct cparser_s
+{
+	cparserdictionary_t *defined;			// Definitions updated while parsing
+	cparserpaths_t *paths;					// Include paths, with the includes resolved by this parser
+	cparserexpression_cache_t *expressions;	// Compiled #if expressions
+};
+
+// Memory of the definitions loaded at once, owned by their dictionary
+typedef struct defines_storage_s
+{
+	uint8_t *text;				// Copy of the definitions text, values point to it
+	object_t *objects;			// Value objects block
+	uint32_t count;				// Value objects count
+} defines_storage_t;
+
 // Parsing state
 typedef struct state_s
 {
-	FILE *file;
+	cparser_t *parser;
+	cparserfile_t *file;
 	states_t state;
 	preprocessor_state_t preprocessor_state;
 	cparserdictionary_t *defined;
@@ -109,31 +132,10 @@ enum eflags_e
 };
 
 
-static const uint8_t *keywords_c[KEYWORDS_C_COUNT] =
-{
-	_T "auto",		_T "break",		_T "case",		_T "char",
-	_T "const",		_T "continue",	_T "default",	_T "do",
-	_T "double",	_T "else",		_T "enum",		_T "extern",
-	_T "float",		_T "for",		_T "goto",		_T "if",
-	_T "inline",	_T "int",		_T "long",		_T "register",
-	_T "restrict",	_T "return",	_T "short",		_T "signed",
-	_T "sizeof",	_T "static",	_T "struct",	_T "switch",
-	_T "typedef",	_T "union",		_T "unsigned",	_T "void",
-	_T "volatile",	_T "while"
-};
-
-static const uint8_t *keywords_preprocessor[KEYWORDS_PREPROCESSOR_COUNT] =
-{
-	_T "define", 	_T "defined",	_T "elif",		_T "else",
-	_T "endif",		_T "error",		_T "if",		_T "ifdef",
-	_T "ifndef",	_T "include",	_T "line",		_T "pragma",
-	_T "undef"
-};
-
-
 static object_t * DigestDataType(object_t *oo, state_t *s)
 {
 	static uint32_t eflags = EFLAGS_NONE;
+	uint32_t kclass = KeywordGetClass(s->token->keyword);
 
 	// Initialize acceptance flags
 	if (oo->children_count == 0)
@@ -142,8 +144,7 @@ static object_t * DigestDataType(object_t *oo, state_t *s)
 	}
 
 	// Compose datatype
-	if (StrEq(_t s->token->str, "static") || StrEq(_t s->token->str, "extern") || StrEq(_t s->token->str, "auto") ||
-			StrEq(_t s->token->str, "register") || StrEq(_t s->token->str, "typedef"))
+	if (kclass & CPARSER_KEYWORD_CLASS_SPECIFIER)
 	{
 		// Check specifiers
 		if (eflags & EFLAGS_SPECIFIER)
@@ -157,7 +158,7 @@ static object_t * DigestDataType(object_t *oo, state_t *s)
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_SPECIFIER, s->token);
 		}
 	}
-	else if (StrEq(_t s->token->str, "const") || StrEq(_t s->token->str, "volatile"))
+	else if (kclass & CPARSER_KEYWORD_CLASS_QUALIFIER)
 	{
 		// Check qualifiers
 		if (eflags & EFLAGS_QUALIFIER)
@@ -171,15 +172,15 @@ static object_t * DigestDataType(object_t *oo, state_t *s)
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_QUALIFIER, s->token);
 		}
 	}
-	else if (StrEq(_t s->token->str, "signed") || StrEq(_t s->token->str, "unsigned") || StrEq(_t s->token->str, "short") || StrEq(_t s->token->str, "long"))
+	else if (kclass & CPARSER_KEYWORD_CLASS_MODIFIER)
 	{
 		// Check modifiers
 		uint32_t newf = 0;
-		if (s->token->str[2] == 'g')
+		if (s->token->keyword == CPARSER_KEYWORD_SIGNED)
 			newf = EFLAGS_MODIFIER_SIGNED;
-		else if (s->token->str[2] == 's')
+		else if (s->token->keyword == CPARSER_KEYWORD_UNSIGNED)
 			newf = EFLAGS_MODIFIER_UNSIGNED;
-		else if (s->token->str[2] == 'o')
+		else if (s->token->keyword == CPARSER_KEYWORD_SHORT)
 			newf = EFLAGS_MODIFIER_SHORT;
 		else
 			newf = EFLAGS_MODIFIER_LONG;
@@ -241,17 +242,17 @@ static object_t * DigestDataType(object_t *oo, state_t *s)
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_MODIFIER, s->token);
 		}
 	}
-	else if (StrEq(_t s->token->str, "void") || StrEq(_t s->token->str, "char") || StrEq(_t s->token->str, "int") || StrEq(_t s->token->str, "float") || StrEq(_t s->token->str, "double"))
+	else if (kclass & CPARSER_KEYWORD_CLASS_PRIMITIVE)
 	{
 		// Check basic built in datatype
 		uint32_t newf = 0;
-		if (s->token->str[0] == 'v')
+		if (s->token->keyword == CPARSER_KEYWORD_VOID)
 			newf = EFLAGS_VOID;
-		else if (s->token->str[0] == 'c')
+		else if (s->token->keyword == CPARSER_KEYWORD_CHAR)
 			newf = EFLAGS_CHAR;
-		else if (s->token->str[0] == 'i')
+		else if (s->token->keyword == CPARSER_KEYWORD_INT)
 			newf = EFLAGS_INT;
-		else if (s->token->str[0] == 'f')
+		else if (s->token->keyword == CPARSER_KEYWORD_FLOAT)
 			newf = EFLAGS_FLOAT;
 		else
 			newf = EFLAGS_DOUBLE;
@@ -292,16 +293,16 @@ static object_t * DigestDataType(object_t *oo, state_t *s)
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_DATATYPE_PRIMITIVE, s->token);
 		}
 	}
-	else if (StrEq(_t s->token->str, "union") || StrEq(_t s->token->str, "enum") || StrEq(_t s->token->str, "struct"))
+	else if (kclass & CPARSER_KEYWORD_CLASS_COMPOSED)
 	{
 		// Possible datatype definition, variable definition, function definition
 		eflags |= ~EFLAGS_COMPOSED_DATATYPE;
 
 		// Add child
 		oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_DATATYPE_USER_DEFINED, s->token);
-		if (s->token->str[0] == 'u')
+		if (s->token->keyword == CPARSER_KEYWORD_UNION)
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_UNION, s->token);
-		else if (s->token->str[0] == 'e')
+		else if (s->token->keyword == CPARSER_KEYWORD_ENUM)
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ENUM, s->token);
 		else
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_STRUCT, s->token);
@@ -319,13 +320,13 @@ static object_t * DigestDataType(object_t *oo, state_t *s)
 	}
 	else if (s->token->type == CPARSER_TOKEN_TYPE_IDENTIFIER)
 	{
-		if (StringInAscendingSet(s->token->str, keywords_c, KEYWORDS_C_COUNT))
+		if (kclass & CPARSER_KEYWORD_CLASS_C)
 		{
 			// Detected C keyword
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
 			oo->info = _T strdup("Use of C keywords as identifiers is not allowed");
 		}
-		else if (DictionaryExistsKey(s->defined, s->token->str))
+		else if (DictionaryExistsAtom(s->defined, s->token->atom))
 		{
 			// Detected identifier already in use
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
@@ -348,7 +349,7 @@ static object_t * DigestDataType(object_t *oo, state_t *s)
 			}
 
 			// Add define identifier to dictionary
-			DictionarySetKeyValue(s->defined, s->token->str, oo);
+			DictionarySetAtomValue(s->defined, s->token->atom, oo);
 		}
 	}
 	else
@@ -459,181 +460,187 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 	{
 
 	case CONDITIONAL_COMPILATION_STATE_IDLE:
-		if (StrEq(_t s->token->str, "include"))
+		switch (s->token->keyword)
 		{
+
+		case CPARSER_KEYWORD_INCLUDE:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_INCLUDE, s->token);	// Add include to preprocessor
 			oo = ObjectGetParent(oo);											// Return to preprocessor
 
 			s->preprocessor_state = PREPROCESSOR_STATE_INCLUDE_FILENAME;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_INCLUDE_FILENAME;
-		}
-		else if (StrEq(_t s->token->str, "define"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_DEFINE:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_DEFINE, s->token);	// Add define to preprocessor object
 			oo = ObjectGetParent(oo);											// Return to preprocessor
 
 			s->preprocessor_state = PREPROCESSOR_STATE_DEFINE_IDENTIFIER;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "undef"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_UNDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_UNDEF, s->token);		// Add undef to preprocessor object
 			oo = ObjectGetParent(oo);											// Return to preprocessor
 
 			s->preprocessor_state = PREPROCESSOR_STATE_UNDEF_IDENTIFIER;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "pragma"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_PRAGMA:
 			__builtin_trap(); // TODO: pragma
-		}
-		else if (StrEq(_t s->token->str, "warning"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_WARNING:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_WARNING, s->token);	// Add warning to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 
 			// Go to preprocessor state ERROR to read error string literal
 			s->preprocessor_state = PREPROCESSOR_STATE_WARNING;
-		}
-		else if (StrEq(_t s->token->str, "error"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ERROR:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ERROR, s->token);	// Add error to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 
 			// Go to preprocessor state ERROR to read error string literal
 			s->preprocessor_state = PREPROCESSOR_STATE_ERROR;
-		}
-		else if (StrEq(_t s->token->str, "if"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_IF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IF, s->token);		// Add undef to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 
 			s->preprocessor_state = PREPROCESSOR_STATE_IF_LITERAL;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_PREPROCESSOR_LITERAL;
-		}
-		else if (StrEq(_t s->token->str, "ifdef"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_IFDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IFDEF, s->token);	// Add ifdef to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 			s->preprocessor_state = PREPROCESSOR_STATE_IFDEF;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "ifndef"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_IFNDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IFNDEF, s->token);	// Add ifndef to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 			s->preprocessor_state = PREPROCESSOR_STATE_IFNDEF;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "elif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELIF:
 			// elif without if
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
 			oo->info = _T strdup("#elif without #if");
 			oo = ObjectGetParent(oo);
 			s->state = STATE_ERROR;
-		}
-		else if (StrEq(_t s->token->str, "else"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELSE:
 			// else without if
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
 			oo->info = _T strdup("#else without #if");
 			oo = ObjectGetParent(oo);
 			s->state = STATE_ERROR;
-		}
-		else if (StrEq(_t s->token->str, "endif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ENDIF:
 			// endif without if
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
 			oo->info = _T strdup("#endif without #if");
 			oo = ObjectGetParent(oo);
 			s->state = STATE_ERROR;
-		}
-		else
-		{
+			break;
+
+		default:
 			// Invalid preprocessor directive
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
 			oo->info = _T strdup("Invalid preprocessor directive");
 			oo = ObjectGetParent(oo);
 			s->state = STATE_ERROR;
+			break;
+
 		}
 		break;
 
 	case CONDITIONAL_COMPILATION_STATE_ACCEPTING:
-		if (StrEq(_t s->token->str, "include"))
+		switch (s->token->keyword)
 		{
+
+		case CPARSER_KEYWORD_INCLUDE:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_INCLUDE, s->token);	// Add include to preprocessor
 			oo = ObjectGetParent(oo);											// Return to preprocessor
 			s->preprocessor_state = PREPROCESSOR_STATE_INCLUDE_FILENAME;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_INCLUDE_FILENAME;
-		}
-		else if (StrEq(_t s->token->str, "define"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_DEFINE:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_DEFINE, s->token);	// Add define to preprocessor object
 			oo = ObjectGetParent(oo);											// Return to preprocessor
 			s->preprocessor_state = PREPROCESSOR_STATE_DEFINE_IDENTIFIER;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "undef"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_UNDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_UNDEF, s->token);		// Add undef to preprocessor object
 			oo = ObjectGetParent(oo);											// Return to preprocessor
 
 			s->preprocessor_state = PREPROCESSOR_STATE_UNDEF_IDENTIFIER;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "pragma"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_PRAGMA:
 			__builtin_trap(); // TODO: pragma
-		}
-		else if (StrEq(_t s->token->str, "warning"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_WARNING:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_WARNING, s->token);	// Add warning to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 
 			// Go to preprocessor state ERROR to read error string literal
 			s->preprocessor_state = PREPROCESSOR_STATE_WARNING;
-		}
-		else if (StrEq(_t s->token->str, "error"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ERROR:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ERROR, s->token);	// Add error to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 
 			// Go to preprocessor state ERROR to read error string literal
 			s->preprocessor_state = PREPROCESSOR_STATE_ERROR;
-		}
-		else if (StrEq(_t s->token->str, "if"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_IF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IF, s->token);		// Add undef to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 
 			s->preprocessor_state = PREPROCESSOR_STATE_IF_LITERAL;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_PREPROCESSOR_LITERAL;
-		}
-		else if (StrEq(_t s->token->str, "ifdef"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_IFDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IFDEF, s->token);	// Add ifdef to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 
 			// Go to preprocessor state and prepare to read a define identifier
 			s->preprocessor_state = PREPROCESSOR_STATE_IFDEF;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "ifndef"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_IFNDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IFNDEF, s->token);	// Add ifndef to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 
 			// Go to preprocessor state and prepare to read a define identifier
 			s->preprocessor_state = PREPROCESSOR_STATE_IFNDEF;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "elif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELIF:
 			__builtin_trap(); // TODO: elif
-		}
-		else if (StrEq(_t s->token->str, "else"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELSE:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ELSE, s->token);		// Add else to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 			oo = ObjectGetParent(oo);														// Return to preprocessor parent
@@ -643,9 +650,9 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 
 			// Update conditional compilation state
 			s->conditional_compilation_state = CONDITIONAL_COMPILATION_STATE_SKIPPING_ELSE;
-		}
-		else if (StrEq(_t s->token->str, "endif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ENDIF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ENDIF, s->token);	// Add endif to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 			oo = ObjectGetParent(oo);														// Return to preprocessor parent
@@ -655,29 +662,39 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 
 			// Pop conditional compilation state
 			StackPop(s->conditional_compilation_stack, &s->conditional_compilation_state);
-		}
-		else
-		{
+			break;
+
+		default:
 			// Invalid preprocessor directive
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
 			oo->info = _T strdup("Invalid preprocessor directive");
 			oo = ObjectGetParent(oo);
 			s->state = STATE_ERROR;
+			break;
+
 		}
 		break;
 
 	case CONDITIONAL_COMPILATION_STATE_LOOKING:
-		if (
-				StrEq(_t s->token->str, "include") || StrEq(_t s->token->str, "define") ||
-				StrEq(_t s->token->str, "undef")   || StrEq(_t s->token->str, "pragma") ||
-				StrEq(_t s->token->str, "warning") || StrEq(_t s->token->str, "error")
-			)
+		switch (s->token->keyword)
 		{
+
+		case CPARSER_KEYWORD_INCLUDE:
+		case CPARSER_KEYWORD_DEFINE:
+		case CPARSER_KEYWORD_UNDEF:
+		case CPARSER_KEYWORD_PRAGMA:
+		case CPARSER_KEYWORD_WARNING:
+		case CPARSER_KEYWORD_ERROR:
 			// Preprocessor directive to skip, so, return to preprocessor parent
 			oo = ObjectGetParent(oo);													// Return to preprocessor parent
-		}
-		else if (StrEq(_t s->token->str, "if") || StrEq(_t s->token->str, "ifdef") || StrEq(_t s->token->str, "ifndef"))
-		{
+
+			// Return preprocessor state to IDLE so the rest of the line is skipped
+			s->preprocessor_state = PREPROCESSOR_STATE_IDLE;
+			break;
+
+		case CPARSER_KEYWORD_IF:
+		case CPARSER_KEYWORD_IFDEF:
+		case CPARSER_KEYWORD_IFNDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IF, s->token);	// Add if to preprocessor object
 			oo = ObjectGetParent(oo);													// Return to preprocessor
 			oo = ObjectGetParent(oo);													// Return to preprocessor parent
@@ -690,13 +707,13 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 
 			// Go directly to skipping conditional compilation state
 			s->conditional_compilation_state = CONDITIONAL_COMPILATION_STATE_SKIPPING;
-		}
-		else if (StrEq(_t s->token->str, "elif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELIF:
 			__builtin_trap(); // TODO: elif
-		}
-		else if (StrEq(_t s->token->str, "else"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELSE:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ELSE, s->token);	// Add else to preprocessor object
 			oo = ObjectGetParent(oo);													// Return to preprocessor
 			oo = ObjectGetParent(oo);													// Return to preprocessor parent
@@ -706,9 +723,9 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 
 			// Go to accepting else conditional compilation state
 			s->conditional_compilation_state = CONDITIONAL_COMPILATION_STATE_ACCEPTING_ELSE;
-		}
-		else if (StrEq(_t s->token->str, "endif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ENDIF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ENDIF, s->token);	// Add endif to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 			oo = ObjectGetParent(oo);														// Return to preprocessor parent
@@ -718,21 +735,37 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 
 			// Pop conditional compilation state
 			StackPop(s->conditional_compilation_stack, &s->conditional_compilation_state);
+			break;
+
+		default:
+			// Unknown preprocessor directive to skip, so, return to preprocessor parent
+			oo = ObjectGetParent(oo);													// Return to preprocessor parent
+			s->preprocessor_state = PREPROCESSOR_STATE_IDLE;
+			break;
+
 		}
 		break;
 
 	case CONDITIONAL_COMPILATION_STATE_SKIPPING:
-		if (
-				StrEq(_t s->token->str, "include") || StrEq(_t s->token->str, "define") ||
-				StrEq(_t s->token->str, "undef")   || StrEq(_t s->token->str, "pragma") ||
-				StrEq(_t s->token->str, "warning") || StrEq(_t s->token->str, "error")
-			)
+		switch (s->token->keyword)
 		{
+
+		case CPARSER_KEYWORD_INCLUDE:
+		case CPARSER_KEYWORD_DEFINE:
+		case CPARSER_KEYWORD_UNDEF:
+		case CPARSER_KEYWORD_PRAGMA:
+		case CPARSER_KEYWORD_WARNING:
+		case CPARSER_KEYWORD_ERROR:
 			// Preprocessor directive to skip, so, return to preprocessor parent
 			oo = ObjectGetParent(oo);													// Return to preprocessor parent
-		}
-		else if (StrEq(_t s->token->str, "if") || StrEq(_t s->token->str, "ifdef") || StrEq(_t s->token->str, "ifndef"))
-		{
+
+			// Return preprocessor state to IDLE so the rest of the line is skipped
+			s->preprocessor_state = PREPROCESSOR_STATE_IDLE;
+			break;
+
+		case CPARSER_KEYWORD_IF:
+		case CPARSER_KEYWORD_IFDEF:
+		case CPARSER_KEYWORD_IFNDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IF, s->token);	// Add endif to preprocessor object
 			oo = ObjectGetParent(oo);													// Return to preprocessor
 			oo = ObjectGetParent(oo);													// Return to preprocessor parent
@@ -742,27 +775,27 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 
 			// Increase conditional compilation stack level
 			StackPush(s->conditional_compilation_stack, &s->conditional_compilation_state);
-		}
-		else if (StrEq(_t s->token->str, "elif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELIF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ELIF, s->token);	// Add elif to preprocessor object
 			oo = ObjectGetParent(oo);													// Return to preprocessor
 			oo = ObjectGetParent(oo);													// Return to preprocessor parent
 
 			// Return preprocessor state to IDLE
 			s->preprocessor_state = PREPROCESSOR_STATE_IDLE;
-		}
-		else if (StrEq(_t s->token->str, "else"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELSE:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ELSE, s->token);	// Add endif to preprocessor object
 			oo = ObjectGetParent(oo);													// Return to preprocessor
 			oo = ObjectGetParent(oo);													// Return to preprocessor parent
 
 			// Return preprocessor state to IDLE
 			s->preprocessor_state = PREPROCESSOR_STATE_IDLE;
-		}
-		else if (StrEq(_t s->token->str, "endif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ENDIF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ENDIF, s->token);	// Add endif to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 			oo = ObjectGetParent(oo);														// Return to preprocessor parent
@@ -772,21 +805,37 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 
 			// Pop conditional compilation state
 			StackPop(s->conditional_compilation_stack, &s->conditional_compilation_state);
+			break;
+
+		default:
+			// Unknown preprocessor directive to skip, so, return to preprocessor parent
+			oo = ObjectGetParent(oo);													// Return to preprocessor parent
+			s->preprocessor_state = PREPROCESSOR_STATE_IDLE;
+			break;
+
 		}
 		break;
 
 	case CONDITIONAL_COMPILATION_STATE_SKIPPING_ELSE:
-		if (
-				StrEq(_t s->token->str, "include") || StrEq(_t s->token->str, "define") ||
-				StrEq(_t s->token->str, "undef")   || StrEq(_t s->token->str, "pragma") ||
-				StrEq(_t s->token->str, "warning") || StrEq(_t s->token->str, "error")
-			)
+		switch (s->token->keyword)
 		{
+
+		case CPARSER_KEYWORD_INCLUDE:
+		case CPARSER_KEYWORD_DEFINE:
+		case CPARSER_KEYWORD_UNDEF:
+		case CPARSER_KEYWORD_PRAGMA:
+		case CPARSER_KEYWORD_WARNING:
+		case CPARSER_KEYWORD_ERROR:
 			// Preprocessor directive to skip, so, return to preprocessor parent
 			oo = ObjectGetParent(oo);													// Return to preprocessor parent
-		}
-		else if (StrEq(_t s->token->str, "if") || StrEq(_t s->token->str, "ifdef") || StrEq(_t s->token->str, "ifndef"))
-		{
+
+			// Return preprocessor state to IDLE so the rest of the line is skipped
+			s->preprocessor_state = PREPROCESSOR_STATE_IDLE;
+			break;
+
+		case CPARSER_KEYWORD_IF:
+		case CPARSER_KEYWORD_IFDEF:
+		case CPARSER_KEYWORD_IFNDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IF, s->token);	// Add if to preprocessor object
 			oo = ObjectGetParent(oo);													// Return to preprocessor
 			oo = ObjectGetParent(oo);													// Return to preprocessor parent
@@ -799,25 +848,25 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 
 			// Go directly to skipping conditional compilation state
 			s->conditional_compilation_state = CONDITIONAL_COMPILATION_STATE_SKIPPING;
-		}
-		else if (StrEq(_t s->token->str, "elif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELIF:
 			// #elif after #else
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
 			oo->info = _T strdup("Invalid #elif after #else");
 			oo = ObjectGetParent(oo);
 			s->state = STATE_ERROR;
-		}
-		else if (StrEq(_t s->token->str, "else"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELSE:
 			// #else after #else
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
 			oo->info = _T strdup("Invalid #else after #else");
 			oo = ObjectGetParent(oo);
 			s->state = STATE_ERROR;
-		}
-		else if (StrEq(_t s->token->str, "endif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ENDIF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ENDIF, s->token);	// Add endif to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 			oo = ObjectGetParent(oo);														// Return to preprocessor parent
@@ -827,92 +876,102 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 
 			// Pop conditional compilation state
 			StackPop(s->conditional_compilation_stack, &s->conditional_compilation_state);
+			break;
+
+		default:
+			// Unknown preprocessor directive to skip, so, return to preprocessor parent
+			oo = ObjectGetParent(oo);													// Return to preprocessor parent
+			s->preprocessor_state = PREPROCESSOR_STATE_IDLE;
+			break;
+
 		}
 		break;
 
 	case CONDITIONAL_COMPILATION_STATE_ACCEPTING_ELSE:
-		if (StrEq(_t s->token->str, "include"))
+		switch (s->token->keyword)
 		{
+
+		case CPARSER_KEYWORD_INCLUDE:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_INCLUDE, s->token);	// Add include to preprocessor
 			oo = ObjectGetParent(oo);											// Return to preprocessor
 			s->preprocessor_state = PREPROCESSOR_STATE_INCLUDE_FILENAME;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_INCLUDE_FILENAME;
-		}
-		else if (StrEq(_t s->token->str, "define"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_DEFINE:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_DEFINE, s->token);		// Add define to preprocessor object
 			oo = ObjectGetParent(oo);											// Return to preprocessor
 			s->preprocessor_state = PREPROCESSOR_STATE_DEFINE_IDENTIFIER;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "undef"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_UNDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_UNDEF, s->token);		// Add undef to preprocessor object
 			oo = ObjectGetParent(oo);											// Return to preprocessor
 
 			s->preprocessor_state = PREPROCESSOR_STATE_UNDEF_IDENTIFIER;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "pragma"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_PRAGMA:
 			__builtin_trap(); // TODO: pragma
-		}
-		else if (StrEq(_t s->token->str, "warning"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_WARNING:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_WARNING, s->token);	// Add warning to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 
 			// Go to preprocessor state ERROR to read error string literal
 			s->preprocessor_state = PREPROCESSOR_STATE_WARNING;
-		}
-		else if (StrEq(_t s->token->str, "error"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ERROR:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ERROR, s->token);	// Add error to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 
 			// Go to preprocessor state ERROR to read error string literal
 			s->preprocessor_state = PREPROCESSOR_STATE_ERROR;
-		}
-		else if (StrEq(_t s->token->str, "if"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_IF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IF, s->token);		// Add undef to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 
 			s->preprocessor_state = PREPROCESSOR_STATE_IF_LITERAL;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_PREPROCESSOR_LITERAL;
-		}
-		else if (StrEq(_t s->token->str, "ifdef"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_IFDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IFDEF, s->token);	// Add ifdef to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 			s->preprocessor_state = PREPROCESSOR_STATE_IFDEF;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "ifndef"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_IFNDEF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IFNDEF, s->token);	// Add ifndef to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 			s->preprocessor_state = PREPROCESSOR_STATE_IFNDEF;
 			s->tokenizer_flags = CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER;
-		}
-		else if (StrEq(_t s->token->str, "elif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELIF:
 			// #elif after #else
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
 			oo->info = _T strdup("Invalid #elif after #else");
 			oo = ObjectGetParent(oo);
 			s->state = STATE_ERROR;
-		}
-		else if (StrEq(_t s->token->str, "else"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ELSE:
 			// #else after #else
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
 			oo->info = _T strdup("Invalid #else after #else");
 			oo = ObjectGetParent(oo);
 			s->state = STATE_ERROR;
-		}
-		else if (StrEq(_t s->token->str, "endif"))
-		{
+			break;
+
+		case CPARSER_KEYWORD_ENDIF:
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_ENDIF, s->token);	// Add endif to preprocessor object
 			oo = ObjectGetParent(oo);														// Return to preprocessor
 			oo = ObjectGetParent(oo);														// Return to preprocessor parent
@@ -922,14 +981,16 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 
 			// Pop conditional compilation state
 			StackPop(s->conditional_compilation_stack, &s->conditional_compilation_state);
-		}
-		else
-		{
+			break;
+
+		default:
 			// Invalid preprocessor directive
 			oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
 			oo->info = _T strdup("Invalid preprocessor directive");
 			oo = ObjectGetParent(oo);
 			s->state = STATE_ERROR;
+			break;
+
 		}
 		break;
 
@@ -941,17 +1002,41 @@ static object_t * ProcessPreprocessorStateNewDirective(object_t *oo, state_t *s)
 	return oo;
 }
 
+static bool IsIncludeGuarded(state_t *s, const uint8_t *filename, atom_t *guard)
+{
+	struct stat st;
+
+	// Only headers found before and guarded by a macro still defined can be skipped
+	if ((filename == NULL) || (s->paths == NULL) || IsCSourceFilename(filename))
+		return false;
+	if (!PathsStatFile(s->paths, filename, &st) || ((*guard = FileGetGuard(&st)) == ATOM_NONE))
+		return false;
+
+	return DictionaryExistsAtom(s->defined, *guard);
+}
+
 static object_t * ProcessPreprocessorStateIncludeFilename(object_t *oo, state_t *s)
 {
 	uint32_t len = strlen(_t s->token->str);
 	uint8_t *filename = (len < 3) ? NULL : _T strndup(_t s->token->str + 1, len - 2);
-	object_t *nn = CParserParse(s->defined, s->paths, filename);
+	object_t *nn;
+	atom_t guard;
+
+	if (IsIncludeGuarded(s, filename, &guard))
+	{
+		// Header would expand to nothing, do not open it again
+		nn = ObjectNewIncludeSkipped(filename, guard);
+	}
+	else
+	{
+		nn = CParserParse(s->parser, filename);
+	}
 
 	oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_INCLUDE_FILENAME, s->token);		// Add include filename
 	oo = ObjectGetParent(oo);														// Return to preprocessor
 	ObjectAddChild(oo, nn);															// Add include object
-	oo = ObjectGetParent(oo);														// Return to preprocessor
 	oo = ObjectGetParent(oo); 														// Return to preprocessor parent
+	free(filename);
 
 	// Return preprocessor state to IDLE
 	s->preprocessor_state = PREPROCESSOR_STATE_IDLE;
@@ -961,7 +1046,7 @@ static object_t * ProcessPreprocessorStateIncludeFilename(object_t *oo, state_t
 
 static object_t * ProcessPreprocessorStateDefineIdentifier(object_t *oo, state_t *s)
 {
-	if (StringInAscendingSet(s->token->str, keywords_c, KEYWORDS_C_COUNT))
+	if (KeywordGetClass(s->token->keyword) & CPARSER_KEYWORD_CLASS_C)
 	{
 		// Trying to define a c keyword
 		oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
@@ -969,7 +1054,7 @@ static object_t * ProcessPreprocessorStateDefineIdentifier(object_t *oo, state_t
 		oo = ObjectGetParent(oo);
 		s->state = STATE_ERROR;
 	}
-	else if (StringInAscendingSet(s->token->str, keywords_preprocessor, KEYWORDS_PREPROCESSOR_COUNT))
+	else if (KeywordGetClass(s->token->keyword) & CPARSER_KEYWORD_CLASS_PREPROCESSOR)
 	{
 		// Trying to define a preprocessor keyword
 		oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
@@ -977,7 +1062,7 @@ static object_t * ProcessPreprocessorStateDefineIdentifier(object_t *oo, state_t
 		oo = ObjectGetParent(oo);
 		s->state = STATE_ERROR;
 	}
-	else if (DictionaryExistsKey(s->defined, s->token->str))
+	else if (DictionaryExistsAtom(s->defined, s->token->atom))
 	{
 		// Trying to redefine an already defined symbol
 		oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
@@ -991,7 +1076,7 @@ static object_t * ProcessPreprocessorStateDefineIdentifier(object_t *oo, state_t
 		oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IDENTIFIER, s->token);		// Add identifier to preprocessor
 
 		// Add define identifier to dictionary
-		DictionarySetKeyValue(s->defined, s->token->str, oo);							// Add definition to dictionary
+		DictionarySetAtomValue(s->defined, s->token->atom, oo);							// Add definition to dictionary
 		oo = ObjectGetParent(oo);														// Return to preprocessor
 
 		// Update state and prepare for parsing a define literal
@@ -1004,7 +1089,7 @@ static object_t * ProcessPreprocessorStateDefineIdentifier(object_t *oo, state_t
 
 static object_t * ProcessPreprocessorStateUndefIdentifier(object_t *oo, state_t *s)
 {
-	if (StringInAscendingSet(s->token->str, keywords_c, KEYWORDS_C_COUNT))
+	if (KeywordGetClass(s->token->keyword) & CPARSER_KEYWORD_CLASS_C)
 	{
 		// Trying to undefine a c keyword
 		oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
@@ -1012,7 +1097,7 @@ static object_t * ProcessPreprocessorStateUndefIdentifier(object_t *oo, state_t
 		oo = ObjectGetParent(oo);
 		s->state = STATE_ERROR;
 	}
-	else if (StringInAscendingSet(s->token->str, keywords_preprocessor, KEYWORDS_PREPROCESSOR_COUNT))
+	else if (KeywordGetClass(s->token->keyword) & CPARSER_KEYWORD_CLASS_PREPROCESSOR)
 	{
 		// Trying to undefine a preprocessor keyword
 		oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_ERROR, s->token);
@@ -1020,7 +1105,7 @@ static object_t * ProcessPreprocessorStateUndefIdentifier(object_t *oo, state_t
 		oo = ObjectGetParent(oo);
 		s->state = STATE_ERROR;
 	}
-	else if (!DictionaryExistsKey(s->defined, s->token->str))
+	else if (!DictionaryExistsAtom(s->defined, s->token->atom))
 	{
 		// Trying to undefine an already undefined symbol
 		oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_WARNING, s->token);
@@ -1034,7 +1119,7 @@ static object_t * ProcessPreprocessorStateUndefIdentifier(object_t *oo, state_t
 		oo = ObjectAddChildFromToken(oo, OBJECT_TYPE_PREPROCESSOR_IDENTIFIER, s->token);	// Add identifier to preprocessor
 
 		// Add define identifier to dictionary
-		DictionaryRemoveKey(s->defined, s->token->str);
+		DictionaryRemoveAtom(s->defined, s->token->atom);
 		oo = ObjectGetParent(oo);															// Return to preprocessor
 		oo = ObjectGetParent(oo);															// Return to preprocessor parent
 
@@ -1318,7 +1403,7 @@ static object_t * ProcessPreprocessorStateIfndef(object_t *oo, state_t *s)
 	StackPush(s->conditional_compilation_stack, &s->conditional_compilation_state);
 
 	// Update conditional compilation state depending on the requested identifier exists or not
-	if (!DictionaryExistsKey(s->defined, s->token->str))
+	if (!DictionaryExistsAtom(s->defined, s->token->atom))
 	{
 		s->conditional_compilation_state = CONDITIONAL_COMPILATION_STATE_ACCEPTING;
 	}
@@ -1343,7 +1428,7 @@ static object_t * ProcessPreprocessorStateIfdef(object_t *oo, state_t *s)
 	StackPush(s->conditional_compilation_stack, &s->conditional_compilation_state);
 
 	// Update conditional compilation state depending on the requested identifier exists or not
-	if (DictionaryExistsKey(s->defined, s->token->str))
+	if (DictionaryExistsAtom(s->defined, s->token->atom))
 	{
 		s->conditional_compilation_state = CONDITIONAL_COMPILATION_STATE_ACCEPTING;
 	}
@@ -1365,8 +1450,8 @@ static object_t * ProcessPreprocessorStateIfLiteral(object_t *oo, state_t *s)
 	// Return preprocessor state to IDLE
 	s->preprocessor_state = PREPROCESSOR_STATE_IDLE;
 
-	// Evaluate expression
-	ExpressionEvalPreprocessor(s->defined, s->token->str, s->token->row, s->token->column, &r);
+	// Evaluate expression, errors are placed at the expression object and positioned when printed
+	ExpressionEvalPreprocessor(s->parser->expressions, s->defined, s->token->str, 0, 0, &r);
 
 	if (r.code == EXPRESSION_RESULT_SUCCESS)
 	{
@@ -1436,6 +1521,22 @@ static object_t * ProcessPreprocessorStateIfLiteral(object_t *oo, state_t *s)
 		{
 			oo->info = _T strdup("Incorrect if preprocessor expression: Last expression token shall be a decoded value.");
 		}
+		else if (r.code == EXPRESSION_RESULT_ERROR_INVALID_NUMBER_LITERAL)
+		{
+			oo->info = _T strdup("Incorrect if preprocessor expression: Invalid integer literal.");
+		}
+		else if (r.code == EXPRESSION_RESULT_ERROR_EXPRESSION_TOO_DEEP)
+		{
+			oo->info = _T strdup("Incorrect if preprocessor expression: Expression too deep.");
+		}
+		else if (r.code == EXPRESSION_RESULT_ERROR_DIVISION_BY_ZERO)
+		{
+			oo->info = _T strdup("Incorrect if preprocessor expression: Division by zero.");
+		}
+		else if (r.code == EXPRESSION_RESULT_ERROR_OVERFLOW)
+		{
+			oo->info = _T strdup("Incorrect if preprocessor expression: Integer overflow.");
+		}
 		else
 		{
 			__builtin_trap(); // TODO: implement lacking error type
@@ -1478,28 +1579,69 @@ static object_t * ProcessPreprocessorStateError(object_t *oo, state_t *s)
 	return oo;
 }
 
-object_t *CParserParse(cparserdictionary_t *dictionary, cparserpaths_t *paths, const uint8_t *filename)
+/**
+ * Creates a parser
+ *
+ * \param[in]	dictionary:	Definitions, updated by the parsed directives. Not owned by the parser
+ * \param[in]	paths:		Include paths, NULL to not open headers. The parser resolves includes on its own copy
+ *
+ * \return new parser
+ */
+cparser_t *CParserNew(cparserdictionary_t *dictionary, cparserpaths_t *paths)
+{
+	cparser_t *parser = malloc(sizeof(cparser_t));
+
+	parser->defined = dictionary;
+	parser->paths = paths ? PathsClone(paths) : NULL;
+	parser->expressions = ExpressionCacheNew();
+
+	return parser;
+}
+
+void CParserDelete(cparser_t *parser)
+{
+	if (parser == NULL)
+		return;
+
+	ExpressionCacheDelete(parser->expressions);
+	if (parser->paths != NULL)
+		PathsDelete(parser->paths);
+	free(parser);
+}
+
+object_t *CParserParse(cparser_t *parser, const uint8_t *filename)
 {
+	cparserdictionary_t *dictionary = parser->defined;
+	cparserpaths_t *paths = parser->paths;
+	object_t *root;
 	object_t *oo;
+	FILE *f;
 	state_t s = {
-			NULL, STATE_IDLE, PREPROCESSOR_STATE_IDLE, dictionary, paths, 0, TokenNew(),
+			parser, NULL, STATE_IDLE, PREPROCESSOR_STATE_IDLE, dictionary, paths, 0, TokenNew(),
 			StackNew(sizeof(conditional_compilation_state_t)), CONDITIONAL_COMPILATION_STATE_IDLE };
 
-	// Create root parse object
-	oo = ObjectAddChildFromToken(NULL, IsCHeaderFilename(filename) ? OBJECT_TYPE_HEADER_FILE : OBJECT_TYPE_SOURCE_FILE, NULL);
-
 	// Open file
 	if (IsCSourceFilename(filename))
 	{
 		// Open source file
-		s.file = filename ? fopen(_t filename, "rb") : NULL;
+		f = filename ? fopen(_t filename, "rb") : NULL;
 	}
 	else
 	{
 		// Open as header file
-		s.file = paths ? PathsOpenFile(paths, filename, _T "rb") : NULL;
+		f = paths ? PathsOpenFile(paths, filename, _T "rb") : NULL;
 	}
 
+	// Map file contents and close it, tokenizer reads from memory from now on
+	if (f != NULL)
+	{
+		s.file = FileNew(f);
+		fclose(f);
+	}
+
+	// Create root parse object, it owns the file contents
+	oo = root = ObjectNewFile(IsCHeaderFilename(filename) ? OBJECT_TYPE_HEADER_FILE : OBJECT_TYPE_SOURCE_FILE, s.file);
+
 	// Check file exists
 	if (s.file == NULL)
 	{
@@ -1514,19 +1656,19 @@ object_t *CParserParse(cparserdictionary_t *dictionary, cparserpaths_t *paths, c
 		oo->data = _T strdup(_t filename);
 	}
 
-	// Prepare token source
-	token_source_t source;
-	TokenSourceInit(&source, s.file, (read_callback_t)fgetc);
+	// Tokens are lexed once per file contents, parser reads them from the stream
+	const cparsertokenstream_t *stream = FileGetStream(s.file);
+	token_stream_reader_t reader;
+
+	if (stream != NULL)
+		TokenStreamReaderInit(&reader, stream);
 
 	// Process tokens from file
-	while ((s.state != STATE_ERROR) && TokenNext(s.token, &source, s.tokenizer_flags))
+	while ((s.state != STATE_ERROR) && TokenStreamReaderNext(&reader, s.token, s.tokenizer_flags))
 	{
 		// Reset flags after read
 		s.tokenizer_flags = 0;
 
-		// Gently printing
-		printf("R%d, C%d, %d:%s\n", s.token->row, s.token->column, s.token->type, s.token->str);
-
 		// Process tokens
 		if (s.token->type == CPARSER_TOKEN_TYPE_C_COMMENT)
 		{
@@ -1536,12 +1678,15 @@ object_t *CParserParse(cparserdictionary_t *dictionary, cparserpaths_t *paths, c
 		{
 			oo = ProcessCppComment(oo, &s);
 		}
-		else if (s.token->type == CPARSER_TOKEN_TYPE_SINGLE_CHAR && s.token->str[0] == '#')
+		else if (s.token->type == CPARSER_TOKEN_TYPE_SINGLE_CHAR && s.token->slice[0] == '#')
 		{
 			oo = ProcessNewDirective(oo, &s);
 		}
 		else
 		{
+			// Comments are stored straight from token slice, the rest of tokens are compared as strings
+			TokenMaterialize(s.token);
+
 			// Process preprocessor states
 			if (s.preprocessor_state == PREPROCESSOR_STATE_NEW_DIRECTIVE)
 			{
@@ -1625,14 +1770,23 @@ object_t *CParserParse(cparserdictionary_t *dictionary, cparserpaths_t *paths, c
 			}
 			else
 			{
-				/* Do nothing in looking, skipping neither skipping else */
-				printf("SKIPPING\n");
+				/* Do nothing in looking, skipping neither skipping else, inactive tokens are dropped */
 			}
 		}
-	}
 
-	// Debugging
-	ObjectPrintRoot(_T "debug.log", oo);
+		// Let the tokenizer skip inactive lines up to the next directive
+		if (
+				(s.preprocessor_state == PREPROCESSOR_STATE_IDLE) &&
+				(
+					(s.conditional_compilation_state == CONDITIONAL_COMPILATION_STATE_LOOKING) ||
+					(s.conditional_compilation_state == CONDITIONAL_COMPILATION_STATE_SKIPPING) ||
+					(s.conditional_compilation_state == CONDITIONAL_COMPILATION_STATE_SKIPPING_ELSE)
+				)
+			)
+		{
+			s.tokenizer_flags |= CPARSER_TOKEN_FLAG_SKIP_INACTIVE_LINES;
+		}
+	}
 
 	// Delete token requested str buffer
 	TokenDelete(s.token);
@@ -1640,5 +1794,134 @@ object_t *CParserParse(cparserdictionary_t *dictionary, cparserpaths_t *paths, c
 	// Delete stack
 	StackDelete(s.conditional_compilation_stack);
 
-	return oo;
+	// File contents and their tokens stay with the root object until it is deleted
+	return root;
+}
+
+static void CParserReleaseDefines(void *storage)
+{
+	defines_storage_t *ds = storage;
+
+	ObjectDeletePreprocessorExpressions(ds->objects, ds->count);
+	free(ds->text);
+	free(ds);
+}
+
+/**
+ * Loads preprocessor definitions from the output of 'gcc -E -dM', in one pass
+ *
+ * Every '#define NAME VALUE' line adds NAME with a preprocessor expression object holding VALUE, or NULL if
+ * VALUE is empty. Function like macros keep their parameters in NAME, as the parser does. Other lines are ignored.
+ * Text is copied once, values and objects are allocated in one block each and belong to the dictionary, which
+ * releases them when deleted.
+ *
+ * \param[in]	text:	Definitions text
+ * \param[in]	size:	Text size
+ *
+ * \return new dictionary with the definitions
+ */
+cparserdictionary_t *CParserLoadDefines(const uint8_t *text, size_t size)
+{
+	uint8_t *buf = malloc(size + 1);
+	uint8_t *end = buf + size;
+	uint8_t *p = buf;
+	uint32_t lines = 1;
+	uint32_t count = 0;
+	uint32_t values = 0;
+	dictionary_atom_pair_t *pairs;
+	uint32_t *indexes;
+	uint8_t **expressions;
+	defines_storage_t *ds;
+	cparserdictionary_t *d;
+
+	// Copy text and size arrays for a definition per line
+	memcpy(buf, text, size);
+	*end = 0;
+	for (size_t i = 0; i < size; i++)
+		lines += (buf[i] == '\n');
+	pairs = malloc(sizeof(dictionary_atom_pair_t) * lines);
+	indexes = malloc(sizeof(uint32_t) * lines);
+	expressions = malloc(sizeof(uint8_t *) * lines);
+
+	for (; p < end; p++)
+	{
+		uint8_t *next = memchr(p, '\n', end - p);
+		uint8_t *eol;
+		uint8_t *name;
+
+		// Lines are processed up to their new line, next line starts after it
+		if (next == NULL)
+			next = end;
+		eol = next;
+
+		// Skip lines that are not definitions
+		while (p < eol && (*p == ' ' || *p == '\t'))
+			p++;
+		if ((eol - p < 8) || memcmp(p, "#define", 7) != 0 || (p[7] != ' ' && p[7] != '\t'))
+		{
+			p = next;
+			continue;
+		}
+		p += 8;
+		while (p < eol && (*p == ' ' || *p == '\t'))
+			p++;
+
+		// Name, with parameters if function like
+		name = p;
+		while (p < eol && *p != ' ' && *p != '\t' && *p != '(' && *p != '\r')
+			p++;
+		if (p < eol && *p == '(')
+		{
+			while (p < eol && *p != ')')
+				p++;
+			if (p < eol)
+				p++;
+		}
+		if (p == name)
+		{
+			p = next;
+			continue;
+		}
+
+		// Names are interned, so they need no terminator in the text
+		pairs[count].key = AtomIntern(name, p - name);
+		pairs[count].value = NULL;
+		indexes[count] = DEFINES_VALUE_NONE;
+
+		// Value, trimmed and terminated in place
+		while (p < eol && (*p == ' ' || *p == '\t'))
+			p++;
+		*eol = 0;
+		while (eol > p && (eol[-1] == ' ' || eol[-1] == '\t' || eol[-1] == '\r'))
+			*--eol = 0;
+		if (p < eol)
+		{
+			indexes[count] = values;		// Object linked below
+			expressions[values++] = p;
+		}
+		count++;
+
+		p = next;
+	}
+
+	// Create all value objects at once and link them to their pairs
+	ds = malloc(sizeof(defines_storage_t));
+	ds->text = buf;
+	ds->objects = ObjectNewPreprocessorExpressions(expressions, values);
+	ds->count = values;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (indexes[i] != DEFINES_VALUE_NONE)
+			pairs[i].value = &ds->objects[indexes[i]];
+	}
+
+	// Dictionary owns the text and the objects
+	d = DictionaryNewFromAtomPairs(pairs, count);
+	DictionarySetStorage(d, ds, CParserReleaseDefines);
+
+	free(pairs);
+	free(indexes);
+	free(expressions);
+
+	return d;
 }
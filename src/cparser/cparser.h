@@ -9,6 +9,12 @@
 #define CPARSER_H_
 
 
-object_t *CParserParse(cparserdictionary_t *dictionary, cparserpaths_t *paths, const uint8_t *filename);
+// Parser keeping its definitions, include paths and compiled expressions between files
+typedef struct cparser_s cparser_t;
+
+cparser_t *CParserNew(cparserdictionary_t *dictionary, cparserpaths_t *paths);
+void CParserDelete(cparser_t *parser);
+object_t *CParserParse(cparser_t *parser, const uint8_t *filename);
+cparserdictionary_t *CParserLoadDefines(const uint8_t *text, size_t size);
 
 #endif /* CPARSER_H_ */
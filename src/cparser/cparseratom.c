@@ -0,0 +1,189 @@
+/*
+ * cparseratom.c
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cparseratom.h"
+
+
+#define ATOM_MIN_SIZE			1024
+#define ATOM_FNV_OFFSET			2166136261u
+#define ATOM_FNV_PRIME			16777619u
+
+
+// Interned strings. Atoms index the string arrays, slots hash atoms by their string
+typedef struct atom_table_s
+{
+	uint32_t *slots;			// Atom of each slot, ATOM_NONE if empty
+	uint32_t slots_size;		// Slot count, power of two
+	const uint8_t **str;		// String of each atom, null terminated
+	uint32_t *length;			// Length of each atom string
+	uint32_t *hash;				// Hash of each atom string
+	uint32_t count;				// Atoms count, including ATOM_NONE
+	uint32_t size;				// Capacity of the atom arrays
+	uint8_t *block;				// Block where next strings are copied
+	uint32_t block_used;		// Bytes used in block
+} atom_table_t;
+
+
+// Atoms are shared by all parsers, they live as long as the process
+static atom_table_t atoms = { NULL, 0, NULL, NULL, NULL, 0, 0, NULL, ATOM_BLOCK_SIZE };
+
+
+static uint32_t AtomHash(const uint8_t *s, uint32_t length)
+{
+	uint32_t h = ATOM_FNV_OFFSET;
+
+	for (uint32_t i = 0; i < length; i++)
+		h = (h ^ s[i]) * ATOM_FNV_PRIME;
+
+	return h;
+}
+
+static uint32_t AtomSlot(const uint8_t *s, uint32_t length, uint32_t h)
+{
+	uint32_t mask = atoms.slots_size - 1;
+	uint32_t i = h & mask;
+
+	// Linear probing up to the atom or an empty slot
+	while (atoms.slots[i] != ATOM_NONE)
+	{
+		atom_t a = atoms.slots[i];
+
+		if (atoms.hash[a] == h && atoms.length[a] == length && memcmp(atoms.str[a], s, length) == 0)
+			break;
+
+		i = (i + 1) & mask;
+	}
+
+	return i;
+}
+
+static void AtomGrow(void)
+{
+	uint32_t *old = atoms.slots;
+	uint32_t old_size = atoms.slots_size;
+
+	// Grow atom arrays
+	atoms.size = (atoms.size == 0) ? ATOM_MIN_SIZE : atoms.size * 2;
+	atoms.str = realloc(atoms.str, sizeof(uint8_t *) * atoms.size);
+	atoms.length = realloc(atoms.length, sizeof(uint32_t) * atoms.size);
+	atoms.hash = realloc(atoms.hash, sizeof(uint32_t) * atoms.size);
+
+	// Keep slots at most half full, rehash atoms
+	atoms.slots_size = atoms.size * 2;
+	atoms.slots = calloc(atoms.slots_size, sizeof(uint32_t));
+	for (uint32_t i = 0; i < old_size; i++)
+	{
+		atom_t a = old[i];
+
+		if (a != ATOM_NONE)
+		{
+			uint32_t j = atoms.hash[a] & (atoms.slots_size - 1);
+
+			while (atoms.slots[j] != ATOM_NONE)
+				j = (j + 1) & (atoms.slots_size - 1);
+			atoms.slots[j] = a;
+		}
+	}
+	free(old);
+
+	// Reserve ATOM_NONE
+	if (atoms.count == 0)
+	{
+		atoms.str[0] = (const uint8_t *)"";
+		atoms.length[0] = 0;
+		atoms.hash[0] = AtomHash(NULL, 0);
+		atoms.count = 1;
+	}
+}
+
+static const uint8_t *AtomCopy(const uint8_t *s, uint32_t length)
+{
+	uint8_t *p;
+
+	// Long strings get their own block, the rest share blocks
+	if (length + 1 > ATOM_BLOCK_SIZE / 4)
+	{
+		p = malloc(length + 1);
+	}
+	else
+	{
+		if (atoms.block_used + length + 1 > ATOM_BLOCK_SIZE)
+		{
+			atoms.block = malloc(ATOM_BLOCK_SIZE);
+			atoms.block_used = 0;
+		}
+		p = atoms.block + atoms.block_used;
+		atoms.block_used += length + 1;
+	}
+
+	memcpy(p, s, length);
+	p[length] = 0;
+
+	return p;
+}
+
+/**
+ * Interns a string, giving the same atom to equal strings
+ *
+ * Atoms are not thread safe, intern only from the parser thread.
+ *
+ * \param[in]	s:		string bytes, not null terminated
+ * \param[in]	length:	string bytes count
+ *
+ * \return atom of the string
+ */
+atom_t AtomIntern(const uint8_t *s, uint32_t length)
+{
+	uint32_t h = AtomHash(s, length);
+	uint32_t i;
+	atom_t a;
+
+	if (atoms.count == atoms.size)
+		AtomGrow();
+
+	// Return atom if already interned
+	i = AtomSlot(s, length, h);
+	if (atoms.slots[i] != ATOM_NONE)
+		return atoms.slots[i];
+
+	// Add atom with a copy of the string
+	a = atoms.count++;
+	atoms.str[a] = AtomCopy(s, length);
+	atoms.length[a] = length;
+	atoms.hash[a] = h;
+	atoms.slots[i] = a;
+
+	return a;
+}
+
+atom_t AtomFind(const uint8_t *s, uint32_t length)
+{
+	if (atoms.count == 0)
+		return ATOM_NONE;
+
+	return atoms.slots[AtomSlot(s, length, AtomHash(s, length))];
+}
+
+const uint8_t *AtomGetString(atom_t atom)
+{
+	return atoms.str[atom];
+}
+
+uint32_t AtomGetLength(atom_t atom)
+{
+	return atoms.length[atom];
+}
+
+uint32_t AtomGetHash(atom_t atom)
+{
+	return atoms.hash[atom];
+}
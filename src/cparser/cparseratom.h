@@ -0,0 +1,28 @@
+/*
+ * cparseratom.h
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#ifndef CPARSER_CPARSERATOM_H_
+#define CPARSER_CPARSERATOM_H_
+
+
+#define ATOM_NONE				0
+
+#define ATOM_BLOCK_SIZE			(1 << 16)	// 64 Kb of interned strings per block
+
+
+// Interned string identifier, equal strings get equal atoms
+typedef uint32_t atom_t;
+
+
+atom_t AtomIntern(const uint8_t *s, uint32_t length);
+atom_t AtomFind(const uint8_t *s, uint32_t length);
+const uint8_t *AtomGetString(atom_t atom);
+uint32_t AtomGetLength(atom_t atom);
+uint32_t AtomGetHash(atom_t atom);
+
+
+#endif /* CPARSER_CPARSERATOM_H_ */
@@ -11,186 +11,759 @@
 #include <stdlib.h>
 #include <string.h>
 #include "cparsertools.h"
+#include "cparseratom.h"
 #include "cparserdictionary.h"
 
 
+#define DICTIONARY_MIN_SLOTS		64
+
+#define HAMT_BITS					5							// Hash bits consumed per trie level
+#define HAMT_MASK					((1 << HAMT_BITS) - 1)
+#define HAMT_MAX_SHIFT				30							// Deeper nodes hold keys with equal hashes
+
+
+// Key and value, kept in insertion order
 typedef struct pair_s
 {
-	const uint8_t *key;
+	atom_t key;					// Key, ATOM_NONE if the pair was removed
 	const void *value;
 } pair_t;
 
+// Hash slot, Robin Hood ordered by distance to the slot the hash points to
+typedef struct slot_s
+{
+	atom_t key;					// Key, ATOM_NONE if slot is empty
+	uint32_t hash;				// Key hash
+	uint32_t index;				// Index of the pair
+} slot_t;
+
+// Persistent trie node, shared by snapshots and copied before a shared node is changed
+typedef struct hamt_node_s hamt_node_t;
+
+// Persistent trie node entry, a key and its value or a child node
+typedef struct hamt_entry_s
+{
+	atom_t key;					// Key, ATOM_NONE if entry is a child node
+	union
+	{
+		const void *value;
+		hamt_node_t *child;
+	};
+} hamt_entry_t;
+
+struct hamt_node_s
+{
+	uint32_t refs;				// Dictionaries and nodes pointing to this node
+	uint32_t bitmap;			// Hash fragments present, entries are sorted by fragment. 0 in equal hashes nodes
+	uint32_t count;				// Entries count
+	hamt_entry_t entries[];
+};
+
 typedef struct cparserdictionary_s
 {
-	pair_t **pairs;
-	int32_t pairs_size;
-	int32_t pairs_count;
+	slot_t *slots;				// Hash slots
+	uint32_t slots_size;		// Slots count, power of two
+	pair_t *pairs;				// Pairs in insertion order, removed ones stay as holes until compaction
+	uint32_t pairs_size;		// Capacity of pairs
+	uint32_t pairs_count;		// Pairs used, including holes
+	uint32_t keys_count;		// Keys in dictionary
+	hamt_node_t *root;			// Trie root once the dictionary is persistent, pairs are then only indexing cache
+	bool persistent;			// True once snapshotted, keys live in the trie instead of slots
+	uint64_t generation;		// Changes stamp, equal stamps mean equal keys and values
+	void *storage;				// Memory values point to, released with the dictionary, NULL if none
+	void (*release)(void *storage);
 } cparserdictionary_t;
 
 
-static int DictionaryKeyCompare(const void * ka, const void * kb)
+// Last stamp given to a dictionary change, shared by all dictionaries so snapshots never reuse one
+static uint64_t dictionary_generation = 0;
+
+
+static inline uint32_t DictionaryDistance(const cparserdictionary_t *d, uint32_t hash, uint32_t i)
+{
+	return (i - hash) & (d->slots_size - 1);
+}
+
+static void DictionaryInsertSlot(cparserdictionary_t *d, slot_t ss)
+{
+	uint32_t mask = d->slots_size - 1;
+	uint32_t i = ss.hash & mask;
+	uint32_t dist = 0;
+
+	// Robin Hood: take the slot of any key closer to its home than the one being inserted
+	while (d->slots[i].key != ATOM_NONE)
+	{
+		uint32_t other = DictionaryDistance(d, d->slots[i].hash, i);
+
+		if (other < dist)
+		{
+			slot_t tmp = d->slots[i];
+			d->slots[i] = ss;
+			ss = tmp;
+			dist = other;
+		}
+
+		i = (i + 1) & mask;
+		dist++;
+	}
+	d->slots[i] = ss;
+}
+
+static void DictionaryRehash(cparserdictionary_t *d, uint32_t slots_size)
+{
+	// Compact pairs while rehashing them into new slots
+	uint32_t j = 0;
+
+	free(d->slots);
+	d->slots_size = slots_size;
+	d->slots = calloc(slots_size, sizeof(slot_t));
+	for (uint32_t i = 0; i < d->pairs_count; i++)
+	{
+		if (d->pairs[i].key != ATOM_NONE)
+		{
+			slot_t ss = { d->pairs[i].key, AtomGetHash(d->pairs[i].key), j };
+
+			d->pairs[j++] = d->pairs[i];
+			DictionaryInsertSlot(d, ss);
+		}
+	}
+	d->pairs_count = j;
+}
+
+static int64_t DictionaryFind(const cparserdictionary_t *d, atom_t key)
+{
+	uint32_t mask = d->slots_size - 1;
+	uint32_t hash;
+	uint32_t i;
+
+	if (key == ATOM_NONE || d->keys_count == 0)
+		return -1;
+
+	// Probe until the key, an empty slot, or a key closer to its home than the probe length
+	hash = AtomGetHash(key);
+	i = hash & mask;
+	for (uint32_t dist = 0; d->slots[i].key != ATOM_NONE; dist++)
+	{
+		if (d->slots[i].key == key)
+			return i;
+		if (DictionaryDistance(d, d->slots[i].hash, i) < dist)
+			break;
+		i = (i + 1) & mask;
+	}
+
+	return -1;
+}
+
+static void DictionaryCompact(cparserdictionary_t *d)
+{
+	// Remove holes left by removed keys so pairs can be indexed
+	if (d->pairs_count != d->keys_count)
+		DictionaryRehash(d, d->slots_size);
+}
+
+static hamt_node_t *HamtNodeNew(uint32_t bitmap, uint32_t count)
+{
+	hamt_node_t *n = malloc(sizeof(hamt_node_t) + sizeof(hamt_entry_t) * count);
+
+	n->refs = 1;
+	n->bitmap = bitmap;
+	n->count = count;
+
+	return n;
+}
+
+static void HamtNodeRelease(hamt_node_t *n)
+{
+	if (n == NULL || --n->refs > 0)
+		return;
+
+	for (uint32_t i = 0; i < n->count; i++)
+	{
+		if (n->entries[i].key == ATOM_NONE)
+			HamtNodeRelease(n->entries[i].child);
+	}
+	free(n);
+}
+
+static hamt_node_t *HamtNodeResize(hamt_node_t *n, uint32_t ix, int32_t delta)
+{
+	// Node with an entry opened (delta 1), closed (delta -1) or kept (delta 0) at ix
+	uint32_t count = n->count + delta;
+	hamt_node_t *m;
+
+	if (n->refs == 1)
+	{
+		// Only owner, change it in place
+		if (delta < 0)
+			memmove(n->entries + ix, n->entries + ix + 1, sizeof(hamt_entry_t) * (n->count - ix - 1));
+		m = realloc(n, sizeof(hamt_node_t) + sizeof(hamt_entry_t) * count);
+		if (delta > 0)
+			memmove(m->entries + ix + 1, m->entries + ix, sizeof(hamt_entry_t) * (m->count - ix));
+		m->count = count;
+
+		return m;
+	}
+
+	// Shared, copy it so the other owners keep the old one
+	m = HamtNodeNew(n->bitmap, count);
+	for (uint32_t i = 0, j = 0; i < n->count; i++, j++)
+	{
+		if (delta > 0 && i == ix)
+			j++;
+		if (delta < 0 && i == ix)
+		{
+			j--;
+			continue;
+		}
+		m->entries[j] = n->entries[i];
+		if (m->entries[j].key == ATOM_NONE)
+			m->entries[j].child->refs++;
+	}
+	n->refs--;
+
+	return m;
+}
+
+static inline uint32_t HamtBit(uint32_t hash, uint32_t shift)
+{
+	// Bitmap bit of the hash fragment at shift, collision nodes below HAMT_MAX_SHIFT have no bitmap
+	return 1u << ((hash >> shift) & HAMT_MASK);
+}
+
+static const hamt_entry_t *HamtFind(const hamt_node_t *n, atom_t key, uint32_t hash)
+{
+	for (uint32_t shift = 0; n != NULL; shift += HAMT_BITS)
+	{
+		const hamt_entry_t *e;
+		uint32_t bit;
+
+		// Keys with equal hashes are searched one by one
+		if (shift > HAMT_MAX_SHIFT)
+		{
+			for (uint32_t i = 0; i < n->count; i++)
+			{
+				if (n->entries[i].key == key)
+					return &n->entries[i];
+			}
+			return NULL;
+		}
+
+		bit = HamtBit(hash, shift);
+		if (!(n->bitmap & bit))
+			return NULL;
+
+		e = &n->entries[__builtin_popcount(n->bitmap & (bit - 1))];
+		if (e->key != ATOM_NONE)
+			return (e->key == key) ? e : NULL;
+		n = e->child;
+	}
+
+	return NULL;
+}
+
+static hamt_node_t *HamtSet(hamt_node_t *n, uint32_t shift, atom_t key, uint32_t hash, const void *value, bool *added)
+{
+	uint32_t bit;
+	uint32_t ix;
+
+	// New node with the key
+	if (n == NULL)
+	{
+		n = HamtNodeNew((shift > HAMT_MAX_SHIFT) ? 0 : HamtBit(hash, shift), 1);
+		n->entries[0].key = key;
+		n->entries[0].value = value;
+		*added = true;
+		return n;
+	}
+
+	// Keys with equal hashes are kept one after another
+	if (shift > HAMT_MAX_SHIFT)
+	{
+		for (ix = 0; ix < n->count; ix++)
+		{
+			if (n->entries[ix].key == key)
+				break;
+		}
+		*added = (ix == n->count);
+		n = HamtNodeResize(n, ix, *added ? 1 : 0);
+		n->entries[ix].key = key;
+		n->entries[ix].value = value;
+		return n;
+	}
+
+	bit = HamtBit(hash, shift);
+	ix = __builtin_popcount(n->bitmap & (bit - 1));
+	if (!(n->bitmap & bit))
+	{
+		// Free fragment, add the key
+		n = HamtNodeResize(n, ix, 1);
+		n->bitmap |= bit;
+		n->entries[ix].key = key;
+		n->entries[ix].value = value;
+		*added = true;
+	}
+	else if (n->entries[ix].key == ATOM_NONE)
+	{
+		// Set the key in the child node, child reference moves to the function
+		n = HamtNodeResize(n, ix, 0);
+		n->entries[ix].child = HamtSet(n->entries[ix].child, shift + HAMT_BITS, key, hash, value, added);
+	}
+	else if (n->entries[ix].key == key)
+	{
+		// Update value
+		n = HamtNodeResize(n, ix, 0);
+		n->entries[ix].value = value;
+		*added = false;
+	}
+	else
+	{
+		// Another key in the fragment, push both keys down a new child node
+		hamt_entry_t e = n->entries[ix];
+		hamt_node_t *child = HamtSet(NULL, shift + HAMT_BITS, e.key, AtomGetHash(e.key), e.value, added);
+
+		child = HamtSet(child, shift + HAMT_BITS, key, hash, value, added);
+		n = HamtNodeResize(n, ix, 0);
+		n->entries[ix].key = ATOM_NONE;
+		n->entries[ix].child = child;
+	}
+
+	return n;
+}
+
+static hamt_node_t *HamtRemove(hamt_node_t *n, uint32_t shift, atom_t key, uint32_t hash)
+{
+	uint32_t bit = 0;
+	uint32_t ix;
+
+	// Trie is left unchanged if the key is not in it
+	if (shift > HAMT_MAX_SHIFT)
+	{
+		for (ix = 0; (ix < n->count) && (n->entries[ix].key != key); ix++)
+			;
+		if (ix == n->count)
+			return n;
+	}
+	else
+	{
+		bit = HamtBit(hash, shift);
+		if (!(n->bitmap & bit))
+			return n;
+
+		ix = __builtin_popcount(n->bitmap & (bit - 1));
+		if ((n->entries[ix].key != ATOM_NONE) && (n->entries[ix].key != key))
+			return n;
+
+		if (n->entries[ix].key == ATOM_NONE)
+		{
+			// Remove the key from the child node, drop the child if it gets empty
+			n = HamtNodeResize(n, ix, 0);
+			n->entries[ix].child = HamtRemove(n->entries[ix].child, shift + HAMT_BITS, key, hash);
+			if (n->entries[ix].child != NULL)
+				return n;
+		}
+	}
+
+	// Remove the entry, and the node if it gets empty
+	if (n->count == 1)
+	{
+		HamtNodeRelease(n);
+		return NULL;
+	}
+
+	n = HamtNodeResize(n, ix, -1);
+	if (shift <= HAMT_MAX_SHIFT)
+		n->bitmap &= ~bit;
+
+	return n;
+}
+
+static void HamtFlatten(const hamt_node_t *n, pair_t *pairs, uint32_t *count)
 {
-	pair_t *kka = *(pair_t **)ka;
-	pair_t *kkb = *(pair_t **)kb;
+	if (n == NULL)
+		return;
 
-	return strcmp(_t kka->key, _t kkb->key);
+	for (uint32_t i = 0; i < n->count; i++)
+	{
+		if (n->entries[i].key == ATOM_NONE)
+		{
+			HamtFlatten(n->entries[i].child, pairs, count);
+		}
+		else
+		{
+			pairs[*count].key = n->entries[i].key;
+			pairs[*count].value = n->entries[i].value;
+			(*count)++;
+		}
+	}
+}
+
+static void DictionaryIndex(cparserdictionary_t *d)
+{
+	// Hashed dictionaries remove their holes, persistent ones list the trie keys
+	if (!d->persistent)
+	{
+		DictionaryCompact(d);
+	}
+	else if (d->pairs_count != d->keys_count)
+	{
+		if (d->pairs_size < d->keys_count)
+		{
+			d->pairs_size = d->keys_count;
+			d->pairs = realloc(d->pairs, sizeof(pair_t) * d->pairs_size);
+		}
+		d->pairs_count = 0;
+		HamtFlatten(d->root, d->pairs, &d->pairs_count);
+	}
 }
 
 cparserdictionary_t * DictionaryNew(void)
 {
 	cparserdictionary_t *d = malloc(sizeof(cparserdictionary_t));
 
+	d->slots = calloc(DICTIONARY_MIN_SLOTS, sizeof(slot_t));
+	d->slots_size = DICTIONARY_MIN_SLOTS;
 	d->pairs = NULL;
 	d->pairs_size = 0;
 	d->pairs_count = 0;
+	d->keys_count = 0;
+	d->root = NULL;
+	d->persistent = false;
+	d->storage = NULL;
+	d->release = NULL;
+	d->generation = ++dictionary_generation;
 
 	return d;
 }
 
-void DictionaryDelete(cparserdictionary_t *d)
+static cparserdictionary_t * DictionaryNewSized(uint32_t count)
 {
-	// Delete key identifiers and pairs
-	while (d->pairs_count--)
+	cparserdictionary_t *d = malloc(sizeof(cparserdictionary_t));
+	uint32_t slots_size = DICTIONARY_MIN_SLOTS;
+
+	// Smallest slots count that keeps slots at most 3/4 full
+	while (4 * (uint64_t)count > 3 * (uint64_t)slots_size)
+		slots_size *= 2;
+
+	d->slots = calloc(slots_size, sizeof(slot_t));
+	d->slots_size = slots_size;
+	d->pairs = malloc(sizeof(pair_t) * (count ? count : 1));
+	d->pairs_size = count ? count : 1;
+	d->pairs_count = 0;
+	d->keys_count = 0;
+	d->root = NULL;
+	d->persistent = false;
+	d->storage = NULL;
+	d->release = NULL;
+	d->generation = ++dictionary_generation;
+
+	return d;
+}
+
+/**
+ * Creates a dictionary with many pairs at once
+ *
+ * Slots and pairs are sized once for all the pairs, so no insertion grows nor rehashes them.
+ * Repeated keys keep the value of their last pair.
+ *
+ * \param[in]	pairs:	Pairs to add, keys are interned
+ * \param[in]	count:	Pairs count
+ *
+ * \return new dictionary
+ */
+cparserdictionary_t * DictionaryNewFromPairs(const dictionary_pair_t *pairs, uint32_t count)
+{
+	cparserdictionary_t *d = DictionaryNewSized(count);
+
+	for (uint32_t i = 0; i < count; i++)
+		DictionarySetAtomValue(d, AtomIntern(pairs[i].key, strlen(_t pairs[i].key)), pairs[i].value);
+
+	return d;
+}
+
+/**
+ * Creates a dictionary with many already interned keys at once
+ *
+ * Same as DictionaryNewFromPairs for callers that hold the atoms of their keys.
+ *
+ * \param[in]	pairs:	Pairs to add
+ * \param[in]	count:	Pairs count
+ *
+ * \return new dictionary
+ */
+cparserdictionary_t * DictionaryNewFromAtomPairs(const dictionary_atom_pair_t *pairs, uint32_t count)
+{
+	cparserdictionary_t *d = DictionaryNewSized(count);
+
+	for (uint32_t i = 0; i < count; i++)
+		DictionarySetAtomValue(d, pairs[i].key, pairs[i].value);
+
+	return d;
+}
+
+/**
+ * Takes a snapshot of a dictionary
+ *
+ * The first snapshot moves the keys of the dictionary into a persistent trie, so it takes time linear in the
+ * keys count. Later snapshots take constant time. The dictionary and all its snapshots share the trie nodes,
+ * and a change copies only the nodes in the path to the changed key, so each of them can be changed, parsed
+ * with, or deleted independently of the others.
+ * Index based accessors of persistent dictionaries list keys in trie order, not in insertion order.
+ *
+ * \param[in/out]	d:	Dictionary to take the snapshot from
+ *
+ * \return new dictionary with the same keys and values as d
+ */
+cparserdictionary_t * DictionarySnapshot(cparserdictionary_t *d)
+{
+	cparserdictionary_t *s = malloc(sizeof(cparserdictionary_t));
+
+	// Move keys into the trie the first time
+	if (!d->persistent)
 	{
-		free((void *)d->pairs[d->pairs_count]->key);
-		free(d->pairs[d->pairs_count]);
+		for (uint32_t i = 0; i < d->pairs_count; i++)
+		{
+			bool added;
+
+			if (d->pairs[i].key != ATOM_NONE)
+				d->root = HamtSet(d->root, 0, d->pairs[i].key, AtomGetHash(d->pairs[i].key), d->pairs[i].value, &added);
+		}
+		free(d->slots);
+		d->slots = NULL;
+		d->slots_size = 0;
+		d->pairs_count = 0;
+		d->persistent = true;
 	}
 
-	// Delete dictionary
-	free(d);
+	// Share the trie
+	s->slots = NULL;
+	s->slots_size = 0;
+	s->pairs = NULL;
+	s->pairs_size = 0;
+	s->pairs_count = 0;
+	s->keys_count = d->keys_count;
+	s->root = d->root;
+	s->persistent = true;
+	s->generation = d->generation;
+	s->storage = NULL;
+	s->release = NULL;
+	if (s->root != NULL)
+		s->root->refs++;
+
+	return s;
 }
 
-void DictionaryRemoveKey(cparserdictionary_t *d, const uint8_t *key)
+void DictionaryDelete(cparserdictionary_t *d)
 {
-	pair_t pp = { key, NULL };
-	pair_t *ppp = &pp;
-	pair_t **p = bsearch(&ppp, d->pairs, d->pairs_count, sizeof(pair_t *), DictionaryKeyCompare);
-	if (!p) return;
+	// Delete slots, pairs and trie, key identifiers are atoms
+	free(d->slots);
+	free(d->pairs);
+	if (d->persistent)
+		HamtNodeRelease(d->root);
 
-	uint32_t ix = p - d->pairs;	// Keys are disposed in a linear array
+	// Release the memory values point to
+	if (d->release != NULL)
+		d->release(d->storage);
 
-	// Delete key identifier and pair
-	free((void *)d->pairs[ix]->key);
-	free(d->pairs[ix]);
+	// Delete dictionary
+	free(d);
+}
 
-	// Decrease pairs, and bulk back copy all remaining pointers
-	d->pairs_count--;
-	memcpy(d->pairs + ix, d->pairs + ix + 1, sizeof(d->pairs[0]) * (d->pairs_count - ix));
+/**
+ * Gives a dictionary the memory its values point to
+ *
+ * Memory is released when the dictionary is deleted, so snapshots taken from it shall be deleted before.
+ *
+ * \param[in/out]	d:			Dictionary
+ * \param[in]		storage:	Memory values point to
+ * \param[in]		release:	Function releasing storage
+ */
+void DictionarySetStorage(cparserdictionary_t *d, void *storage, void (*release)(void *storage))
+{
+	d->storage = storage;
+	d->release = release;
 }
 
-void DictionarySetKeyValue(cparserdictionary_t *d, const uint8_t *key, const void *value)
+void DictionaryRemoveAtom(cparserdictionary_t *d, atom_t key)
 {
-	int ix = 0;
-	pair_t pp = { key, NULL };
-	pair_t *ppp = &pp;
-	pair_t **p = bsearch(&ppp, d->pairs, d->pairs_count, sizeof(pair_t *), DictionaryKeyCompare);
-	pair_t *q;
+	uint32_t mask = d->slots_size - 1;
+	int64_t found;
+	uint32_t i;
 
-	// Add pair if no key found
-	if (!p)
+	// Remove from trie, copying its shared nodes
+	if (d->persistent)
 	{
-		// Increase pairs size if pairs array is full
-		if ( d->pairs_count == d->pairs_size)
+		if (key != ATOM_NONE && HamtFind(d->root, key, AtomGetHash(key)) != NULL)
 		{
-			// Create new size and array
-			uint32_t ss = d->pairs_size + 100;
-			pair_t **pp = malloc(sizeof(pair_t) * ss);
+			d->root = HamtRemove(d->root, 0, key, AtomGetHash(key));
+			d->keys_count--;
+			d->pairs_count = 0;
+			d->generation = ++dictionary_generation;
+		}
+		return;
+	}
 
-			// Copy old data into new array and delete old data
-			memcpy(pp, d->pairs, sizeof(pair_t *) * d->pairs_count);
-			free(d->pairs);
+	found = DictionaryFind(d, key);
+	if (found < 0)
+		return;
 
-			// Update dictionary pairs and size
-			d->pairs = pp;
-			d->pairs_size = ss;
-		}
+	// Leave a hole in pairs
+	d->generation = ++dictionary_generation;
+	i = found;
+	d->pairs[d->slots[i].index].key = ATOM_NONE;
+	d->keys_count--;
 
-		// Create a new pair
-		q = malloc(sizeof(pair_t));
-		q->key = _T strdup(_t key);
-		q->value = value;
+	// Shift back following slots until an empty one or one at its home
+	for (;;)
+	{
+		uint32_t next = (i + 1) & mask;
 
-		// Look for insert index
-		if (d->pairs_count > 0)
-		{
-			ix = d->pairs_count / 2;
-			int32_t delta = ix / 2;
+		if (d->slots[next].key == ATOM_NONE || DictionaryDistance(d, d->slots[next].hash, next) == 0)
+			break;
+		d->slots[i] = d->slots[next];
+		i = next;
+	}
+	d->slots[i].key = ATOM_NONE;
 
-			// Stride over pairs
-			while (delta)
-			{
-				if (strcmp(_t key, _t d->pairs[ix]->key) < 0)
-					ix -= delta;
-				else
-					ix += delta;
+	// Compact when holes are the most of pairs
+	if (d->pairs_count > 2 * d->keys_count + DICTIONARY_MIN_SLOTS)
+		DictionaryCompact(d);
+}
 
-				delta /= 2;
-			}
+void DictionaryRemoveKey(cparserdictionary_t *d, const uint8_t *key)
+{
+	DictionaryRemoveAtom(d, AtomFind(key, strlen(_t key)));
+}
 
-			// Step over pairs
-			while (ix > 0 && strcmp(_t key, _t d->pairs[ix - 1]->key) < 0)
-				ix--;
+void DictionarySetAtomValue(cparserdictionary_t *d, atom_t key, const void *value)
+{
+	int64_t found;
 
-			// Step over pairs
-			while (ix < d->pairs_count && strcmp(_t key, _t d->pairs[ix]->key) > 0)
-				ix++;
+	d->generation = ++dictionary_generation;
 
-			// Move forward all pointers
-			for (int i = d->pairs_count; i > ix; i--)
-				d->pairs[i] = d->pairs[i - 1];
-		}
+	// Set in trie, copying its shared nodes
+	if (d->persistent)
+	{
+		bool added = false;
 
-		// Insert the new pair and increase pairs count
-		d->pairs[ix] = q;
-		d->pairs_count++;
+		d->root = HamtSet(d->root, 0, key, AtomGetHash(key), value, &added);
+		d->keys_count += added;
+		d->pairs_count = 0;
+		return;
 	}
-	else
+
+	found = DictionaryFind(d, key);
+
+	// Update value in found key
+	if (found >= 0)
+	{
+		d->pairs[d->slots[found].index].value = value;
+		return;
+	}
+
+	// Keep slots at most 3/4 full
+	if (4 * (d->keys_count + 1) > 3 * d->slots_size)
+		DictionaryRehash(d, d->slots_size * 2);
+
+	// Increase pairs size if pairs array is full
+	if (d->pairs_count == d->pairs_size)
 	{
-		// Update value in found key
-		(*p)->value = value;
+		d->pairs_size = d->pairs_size ? d->pairs_size * 2 : DICTIONARY_MIN_SLOTS;
+		d->pairs = realloc(d->pairs, sizeof(pair_t) * d->pairs_size);
 	}
+
+	// Append the new pair and hash it
+	slot_t ss = { key, AtomGetHash(key), d->pairs_count };
+	d->pairs[d->pairs_count].key = key;
+	d->pairs[d->pairs_count].value = value;
+	d->pairs_count++;
+	d->keys_count++;
+	DictionaryInsertSlot(d, ss);
 }
 
-bool DictionaryExistsKey(cparserdictionary_t *d, const uint8_t *key)
+void DictionarySetKeyValue(cparserdictionary_t *d, const uint8_t *key, const void *value)
 {
-	pair_t pp = { key, NULL };
-	pair_t *ppp = &pp;
-	pair_t **p;
+	DictionarySetAtomValue(d, AtomIntern(key, strlen(_t key)), value);
+}
 
+bool DictionaryExistsAtom(cparserdictionary_t *d, atom_t key)
+{
 	if (d == NULL)
 		return NULL;
 
-	p = bsearch(&ppp, d->pairs, d->pairs_count, sizeof(pair_t *), DictionaryKeyCompare);
+	if (d->persistent)
+		return key != ATOM_NONE && HamtFind(d->root, key, AtomGetHash(key)) != NULL;
+
+	return DictionaryFind(d, key) >= 0;
+}
+
+bool DictionaryExistsKey(cparserdictionary_t *d, const uint8_t *key)
+{
+	if (d == NULL)
+		return NULL;
+
+	return DictionaryExistsAtom(d, AtomFind(key, strlen(_t key)));
+}
+
+const void * DictionaryGetAtomValue(cparserdictionary_t *d, atom_t key)
+{
+	int64_t found;
+
+	if (d->persistent)
+	{
+		const hamt_entry_t *e = (key != ATOM_NONE) ? HamtFind(d->root, key, AtomGetHash(key)) : NULL;
+
+		return e ? e->value : NULL;
+	}
+
+	found = DictionaryFind(d, key);
 
-	return p != NULL;
+	return (found >= 0) ? d->pairs[d->slots[found].index].value : NULL;
 }
 
 const void * DictionaryGetKeyValue(cparserdictionary_t *d, const uint8_t *key)
 {
-	pair_t pp = { key, NULL };
-	pair_t *ppp = &pp;
-	pair_t **p = bsearch(&ppp, d->pairs, d->pairs_count, sizeof(pair_t *), DictionaryKeyCompare);
+	return DictionaryGetAtomValue(d, AtomFind(key, strlen(_t key)));
+}
 
-	return p ? (*p)->value : NULL;
+/**
+ * Gets the stamp of the last change of a dictionary
+ *
+ * Every key set or removal gives the dictionary a new stamp, different from any other dictionary stamp. A snapshot
+ * keeps the stamp of its origin until either of them changes, so values computed from a dictionary stay valid
+ * while its stamp does not change.
+ *
+ * \param[in]	d:	Dictionary
+ *
+ * \return stamp of the last change
+ */
+uint64_t DictionaryGetGeneration(cparserdictionary_t *d)
+{
+	return d->generation;
 }
 
 uint32_t DictionaryGetKeyCount(cparserdictionary_t *d)
 {
-	return d->pairs_count;
+	return d->keys_count;
 }
 
 const uint8_t * DictionaryGetKeyByIndex(cparserdictionary_t *d, uint32_t ix)
 {
-	if (ix >= d->pairs_count)
+	if (ix >= d->keys_count)
 		return NULL;
 
-	return d->pairs[ix]->key;
+	// Keys are indexed in insertion order, or trie order if persistent
+	DictionaryIndex(d);
+
+	return AtomGetString(d->pairs[ix].key);
 }
 
 const void * DictionaryGetValueByIndex(cparserdictionary_t *d, uint32_t ix)
 {
-	if (ix >= d->pairs_count)
+	if (ix >= d->keys_count)
 		return NULL;
 
-	return d->pairs[ix]->value;
+	// Values are indexed in insertion order, or trie order if persistent
+	DictionaryIndex(d);
+
+	return d->pairs[ix].value;
 }
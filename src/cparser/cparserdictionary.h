@@ -12,14 +12,37 @@
 struct cparserdictionary_s;
 typedef struct cparserdictionary_s cparserdictionary_t;
 
+// Key and value to build a dictionary at once
+typedef struct dictionary_pair_s
+{
+	const uint8_t *key;
+	const void *value;
+} dictionary_pair_t;
+
+// Interned key and value to build a dictionary at once
+typedef struct dictionary_atom_pair_s
+{
+	atom_t key;
+	const void *value;
+} dictionary_atom_pair_t;
+
 
 cparserdictionary_t * DictionaryNew(void);
+cparserdictionary_t * DictionaryNewFromPairs(const dictionary_pair_t *pairs, uint32_t count);
+cparserdictionary_t * DictionaryNewFromAtomPairs(const dictionary_atom_pair_t *pairs, uint32_t count);
+cparserdictionary_t * DictionarySnapshot(cparserdictionary_t *d);
 void DictionaryDelete(cparserdictionary_t *d);
+void DictionarySetStorage(cparserdictionary_t *d, void *storage, void (*release)(void *storage));
 void DictionaryRemoveKey(cparserdictionary_t *d, const uint8_t *key);
+void DictionaryRemoveAtom(cparserdictionary_t *d, atom_t key);
 void DictionarySetKeyValue(cparserdictionary_t *d, const uint8_t *key, const void *value);
+void DictionarySetAtomValue(cparserdictionary_t *d, atom_t key, const void *value);
 const bool DictionaryExistsKey(cparserdictionary_t *d, const uint8_t *key);
+const bool DictionaryExistsAtom(cparserdictionary_t *d, atom_t key);
 const void * DictionaryGetKeyValue(cparserdictionary_t *d, const uint8_t *key);
+const void * DictionaryGetAtomValue(cparserdictionary_t *d, atom_t key);
 uint32_t DictionaryGetKeyCount(cparserdictionary_t *d);
+uint64_t DictionaryGetGeneration(cparserdictionary_t *d);
 const uint8_t * DictionaryGetKeyByIndex(cparserdictionary_t *d, uint32_t ix);
 const void * DictionaryGetValueByIndex(cparserdictionary_t *d, uint32_t ix);
 
@@ -8,1043 +8,1039 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include "cparsertools.h"
+#include "cparserkeyword.h"
 #include "cparsertoken.h"
+#include "cparseratom.h"
+#include "cparserliteral.h"
 #include "cparserdictionary.h"
-#include "cparserlinkedlist.h"
+#include "cparserlines.h"
+#include "cparserfile.h"
 #include "cparserobject.h"
 #include "cparserexpression.h"
 
 
-#define VALID_OPERATORS_COUNT			20
-#define VALID_UNARY_OPERATORS_COUNT		4
 #define STR(A)							(#A)
 
+#define EXPRESSION_STACK_SIZE			128		// Pending operators and operands, deeper expressions are rejected
+#define EXPRESSION_PRECEDENCE_NONE		0		// Open parenthesis, never reduced by an operator
+#define EXPRESSION_PRECEDENCE_UNARY		11		// Unary operators bind tighter than any binary one
+#define EXPRESSION_CODES_MIN_SIZE		16
+#define EXPRESSION_VALUE_BITS			(sizeof(intmax_t) * CHAR_BIT)
+#define EXPRESSION_CACHE_MIN_SIZE		256		// Initial cache slots, power of two
+#define EXPRESSION_FNV_OFFSET			2166136261u
+#define EXPRESSION_FNV_PRIME			16777619u
 
-typedef enum expression_token_type_e
+
+
+// Bytecode instruction, operands are pushed before their operators
+typedef enum expression_opcode_e
 {
-	EXPRESSION_TOKEN_TYPE_DEFINED,
-	EXPRESSION_TOKEN_TYPE_IDENTIFIER,
-	EXPRESSION_TOKEN_TYPE_OPERATOR,
-	EXPRESSION_TOKEN_TYPE_OPEN,
-	EXPRESSION_TOKEN_TYPE_CLOSE,
-	EXPRESSION_TOKEN_TYPE_DECODED_VALUE
-} expression_token_type_t;
-
-typedef struct expression_token_s
+	EXPRESSION_OPCODE_VALUE = 0,		// Push value
+	EXPRESSION_OPCODE_DEFINITION,		// Push value of the definition of an atom, 0 if not defined
+	EXPRESSION_OPCODE_DEFINED,			// Push 1 if an atom is defined, 0 otherwise
+	EXPRESSION_OPCODE_UNARY,			// Replace top value by the result of an unary operator
+	EXPRESSION_OPCODE_BINARY,			// Replace top two values by the result of a binary operator
+	EXPRESSION_OPCODE_JUMP_IF_FALSE,	// Replace top value by 0 and jump to code index value if it is 0, pop it otherwise
+	EXPRESSION_OPCODE_JUMP_IF_TRUE,		// Replace top value by 1 and jump to code index value if it is not 0, pop it otherwise
+	EXPRESSION_OPCODE_LOGICAL			// Replace top value by 1 if it is not 0
+} expression_opcode_t;
+
+typedef struct expression_code_s
 {
-	expression_token_type_t type;
+	uint8_t opcode;				// EXPRESSION_OPCODE_XXX
+	uint8_t op;					// CPARSER_OPERATOR_XXX of unary and binary operators
+	bool is_unsigned;			// Value is uintmax_t
 	uint32_t row;
 	uint32_t column;
-	void *data;
-} expression_token_t;
+	intmax_t value;				// Value, or atom of definition and defined opcodes
+} expression_code_t;
 
+// Evaluated value, preprocessor arithmetic is done in intmax_t or uintmax_t
+typedef struct expression_value_s
+{
+	intmax_t value;
+	bool is_unsigned;
+} expression_value_t;
 
-static const uint8_t *valid_operators[VALID_OPERATORS_COUNT] = {
-		_T "!", _T "!=", _T "%",  _T "&",  _T "&&",
-		_T "*", _T "+",  _T "-",  _T "/",
-		_T "<", _T "<<", _T "<=", _T "==", _T ">", _T ">=", _T ">>",
-		_T "^", _T "|",  _T "||", _T "~"
-};
+// Compiled expression, shared by every evaluation of the same expression text
+typedef struct expression_bytecode_s
+{
+	cparserexpression_result_code_t code;	// Compilation result, syntax errors do not depend on definitions
+	uint32_t row;							// Compilation error position
+	uint32_t column;
+	atom_t *depends;						// Atoms the value depends on, without duplicates
+	uint32_t depends_count;
+	const uint8_t *text;					// Expression text, null terminated
+	uint32_t length;						// Expression text length
+	uint32_t hash;							// Expression text hash
+	uint32_t codes_count;
+	expression_code_t codes[];
+} expression_bytecode_t;
+
+// Operator waiting for its right operand
+typedef struct expression_operator_s
+{
+	uint8_t op;					// CPARSER_OPERATOR_XXX, CPARSER_OPERATOR_NONE for open parenthesis
+	uint8_t precedence;			// EXPRESSION_PRECEDENCE_XXX or binary operator precedence
+	uint32_t jump;				// Code index of the jump skipping the right operand of && and ||
+	uint32_t row;
+	uint32_t column;
+} expression_operator_t;
 
-static const uint8_t *valid_unary_operators[VALID_UNARY_OPERATORS_COUNT] = {
-		_T "!", _T "+",  _T "-",  _T "~"
+// Compilation state, operators wait in the stack for operators with lower precedence
+typedef struct expression_compiler_s
+{
+	expression_operator_t operators[EXPRESSION_STACK_SIZE];
+	uint32_t operators_count;
+	uint32_t values_count;		// Values in the stack when the code emitted so far runs
+	expression_code_t *codes;
+	uint32_t codes_size;
+	uint32_t codes_count;
+	atom_t *depends;
+	uint32_t depends_size;
+	uint32_t depends_count;
+} expression_compiler_t;
+
+// How an operator binds in preprocessor expressions
+typedef struct expression_operator_class_s
+{
+	uint8_t precedence;			// Binary operator precedence, higher binds tighter. EXPRESSION_PRECEDENCE_NONE if not binary
+	bool unary;					// True if it can be an unary operator
+} expression_operator_class_t;
+
+
+// Operators valid in preprocessor expressions, the rest have no precedence and are not unary
+static const expression_operator_class_t operator_classes[CPARSER_OPERATOR_COUNT] = {
+		[CPARSER_OPERATOR_MUL] =			{ 10, false },
+		[CPARSER_OPERATOR_DIV] =			{ 10, false },
+		[CPARSER_OPERATOR_MOD] =			{ 10, false },
+		[CPARSER_OPERATOR_ADD] =			{ 9, true },
+		[CPARSER_OPERATOR_SUB] =			{ 9, true },
+		[CPARSER_OPERATOR_SHIFT_LEFT] =		{ 8, false },
+		[CPARSER_OPERATOR_SHIFT_RIGHT] =	{ 8, false },
+		[CPARSER_OPERATOR_LESS] =			{ 7, false },
+		[CPARSER_OPERATOR_LESS_EQUAL] =		{ 7, false },
+		[CPARSER_OPERATOR_GREATER] =		{ 7, false },
+		[CPARSER_OPERATOR_GREATER_EQUAL] =	{ 7, false },
+		[CPARSER_OPERATOR_EQUAL] =			{ 6, false },
+		[CPARSER_OPERATOR_NOT_EQUAL] =		{ 6, false },
+		[CPARSER_OPERATOR_BIT_AND] =		{ 5, false },
+		[CPARSER_OPERATOR_BIT_XOR] =		{ 4, false },
+		[CPARSER_OPERATOR_BIT_OR] =			{ 3, false },
+		[CPARSER_OPERATOR_LOGICAL_AND] =	{ 2, false },
+		[CPARSER_OPERATOR_LOGICAL_OR] =		{ 1, false },
+		[CPARSER_OPERATOR_BIT_NOT] =		{ EXPRESSION_PRECEDENCE_NONE, true },
+		[CPARSER_OPERATOR_LOGICAL_NOT] =	{ EXPRESSION_PRECEDENCE_NONE, true },
 };
 
-static int GetNextChar(void *data)
+
+// Compiled expressions by expression text, slots are kept at most half full
+struct cparserexpression_cache_s
 {
-	int res;
-	char **pp = (char **)data;
+	expression_bytecode_t **slots;			// Compiled expression of each slot, NULL if empty
+	uint32_t slots_size;					// Slot count, power of two
+	uint32_t count;							// Compiled expressions count
+};
 
-	if (!**pp)
-		return EOF;
 
-	res = **pp;
-	*pp = *pp + 1;
+static void ExpressionEval(cparserexpression_cache_t *cache, cparserdictionary_t *defines, const uint8_t *expression, uint32_t row, uint32_t column,
+		cparserexpression_result_t *res, const expression_bytecode_t **bytecode, bool *cacheable);
 
-	return res;
+static void ExpressionError(cparserexpression_result_t *res, cparserexpression_result_code_t code, uint32_t row, uint32_t column)
+{
+	res->code = code;
+	res->value = 0;
+	res->is_unsigned = false;
+	res->row = row;
+	res->column = column;
 }
 
-static void ExpressionTokenDelete(expression_token_t *et)
+static object_t *ExpressionGetDefinition(cparserdictionary_t *defines, atom_t atom)
 {
-	if (et == NULL)
-		return;
+	object_t *oo = (object_t *)DictionaryGetAtomValue(defines, atom);
+	object_t *expression;
+
+	// Definitions parsed from a #define are its identifier, their expression follows it in the directive
+	if ((oo != NULL) && (oo->type == OBJECT_TYPE_PREPROCESSOR_IDENTIFIER))
+	{
+		expression = ObjectGetChildByType(ObjectGetParent(oo), OBJECT_TYPE_PREPROCESSOR_EXPRESSION);
+		if (expression != NULL)
+			oo = expression;
+	}
 
-	// Delete expression token data and token
-	if ((et->type != EXPRESSION_TOKEN_TYPE_DECODED_VALUE) && (et->data != NULL))
-		free(et->data);
-	free(et);
+	return oo;
 }
 
-static void LinkedExpressionListDelete(cparserlinkedlist_t *l)
+static bool ExpressionValueIsValid(cparserdictionary_t *defines, object_t *definition, uint64_t generation)
 {
-	expression_token_t *et = NULL;
+	uint64_t checked = definition->value_generation;
+	bool valid = true;
 
-	while (l != NULL)
-	{
-		// Get expression token
-		et = LinkedListGetItem(l);
+	if ((checked == OBJECT_VALUE_CONSTANT) || (checked == generation))
+		return true;
+	if ((checked == OBJECT_VALUE_NONE) || (checked == OBJECT_VALUE_EVALUATING))
+		return false;
 
-		ExpressionTokenDelete(et);
+	// Definitions changed since the value was checked, it holds while the ones it depends on hold
+	definition->value_generation = OBJECT_VALUE_EVALUATING;
+	for (uint32_t i = 0; valid && (i < definition->value_bindings_count); i++)
+	{
+		const object_binding_t *b = &definition->value_bindings[i];
+		object_t *dependency = ExpressionGetDefinition(defines, b->atom);
 
-		// Delete linked list node
-		l = LinkedListDelete(l);
+		if (dependency != b->definition)
+			valid = false;
+		else if (b->value_stamp != 0)
+			valid = ExpressionValueIsValid(defines, dependency, generation) && (dependency->value_stamp == b->value_stamp);
 	}
+	definition->value_generation = valid ? generation : checked;
+
+	return valid;
 }
 
-static void LinkedExpressionListPrint(cparserlinkedlist_t *l)
+static void ExpressionStoreValue(cparserdictionary_t *defines, object_t *definition, const expression_bytecode_t *bc, expression_value_t ev, uint64_t generation)
 {
-	expression_token_t *et = NULL;
-
-	l = LinkedListFirst(l);
-
-	while (l != NULL)
+	// Stamp changes only with the value, so the values depending on it stay valid otherwise
+	if ((definition->value_stamp == 0) || (definition->value != ev.value) || (definition->value_unsigned != ev.is_unsigned))
+		definition->value_stamp++;
+	definition->value = ev.value;
+	definition->value_unsigned = ev.is_unsigned;
+
+	// Values without dependencies never change
+	if (bc->depends_count == 0)
 	{
-		et = LinkedListGetItem(l);
-
-		switch (et->type)
-		{
+		definition->value_bindings_count = 0;
+		definition->value_generation = OBJECT_VALUE_CONSTANT;
+		return;
+	}
 
-		case EXPRESSION_TOKEN_TYPE_DEFINED:
-			printf("defined ");
-			break;
+	// Record the definitions the value was evaluated with
+	definition->value_bindings = realloc(definition->value_bindings, sizeof(object_binding_t) * bc->depends_count);
+	definition->value_bindings_count = bc->depends_count;
+	for (uint32_t i = 0; i < bc->depends_count; i++)
+	{
+		const object_t *dependency = ExpressionGetDefinition(defines, bc->depends[i]);
+		object_binding_t *b = &definition->value_bindings[i];
 
-		case EXPRESSION_TOKEN_TYPE_IDENTIFIER:
-			printf("%s ", (char *)et->data);
-			break;
+		b->atom = bc->depends[i];
+		b->definition = dependency;
+		b->value_stamp = ((dependency != NULL) && (dependency->type == OBJECT_TYPE_PREPROCESSOR_EXPRESSION)) ? dependency->value_stamp : 0;
+	}
+	definition->value_generation = generation;
+}
 
-		case EXPRESSION_TOKEN_TYPE_OPERATOR:
-			printf("%s ", (char *)et->data);
-			break;
+static expression_value_t ExpressionEvalDefinition(cparserexpression_cache_t *cache, cparserdictionary_t *defines, atom_t atom, uint32_t row, uint32_t column, cparserexpression_result_t *res, bool *cacheable)
+{
+	object_t *definition = ExpressionGetDefinition(defines, atom);
+	const object_t *oo = definition;
+	expression_value_t ev = { 0, false };
+	const expression_bytecode_t *bc;
+	uint64_t generation;
+	bool own = true;
+
+	// Undefined identifiers are 0
+	res->code = EXPRESSION_RESULT_SUCCESS;
+	if (oo == NULL)
+		return ev;
 
-		case EXPRESSION_TOKEN_TYPE_OPEN:
-			printf("( ");
-			break;
+	if (oo->type != OBJECT_TYPE_PREPROCESSOR_EXPRESSION)
+	{
+		// No valid preprocessor expression can be found in dictionary
+		ExpressionError(res, EXPRESSION_RESULT_ERROR_NO_VALID_PREPROCESSOR_EXPRESSION_FOUND, row, column);
+		return ev;
+	}
 
-		case EXPRESSION_TOKEN_TYPE_CLOSE:
-			printf(") ");
-			break;
+	// A definition referenced from its own evaluation is not expanded again, it is 0 like any other identifier
+	if (definition->value_generation == OBJECT_VALUE_EVALUATING)
+	{
+		*cacheable = false;
+		return ev;
+	}
 
-		case EXPRESSION_TOKEN_TYPE_DECODED_VALUE:
-			printf("%ld ", (intptr_t)et->data);
-			break;
+	// Take the value cached by a former evaluation while the definitions it depends on did not change
+	generation = DictionaryGetGeneration(defines);
+	if (ExpressionValueIsValid(defines, definition, generation))
+	{
+		ev.value = definition->value;
+		ev.is_unsigned = definition->value_unsigned;
+		return ev;
+	}
 
-		default:
-			break;
+	// Recursively evaluate the expression
+	definition->value_generation = OBJECT_VALUE_EVALUATING;
+	ExpressionEval(cache, defines, oo->data, row, column, res, &bc, &own);
+	definition->value_generation = OBJECT_VALUE_NONE;
+	if (res->code != EXPRESSION_RESULT_SUCCESS)
+		return ev;
 
-		}
+	ev.value = res->value;
+	ev.is_unsigned = res->is_unsigned;
 
-		l = LinkedListNext(l);
-	}
+	// Values that met a reference not expanded depend on where they are evaluated from, they are not cached
+	if (own)
+		ExpressionStoreValue(defines, definition, bc, ev, generation);
+	else
+		*cacheable = false;
 
-	printf("\n");
+	return ev;
 }
 
-static void LinkedExpressionListComputeDefined(cparserlinkedlist_t *l, cparserdictionary_t *defines, cparserexpression_result_t *res)
+static bool ExpressionNextToken(token_t *tt, token_source_t *source)
 {
-	enum eval_defined_state_e
+	// Next token, skipping comments and line continuations
+	while (TokenNext(tt, source, 0))
 	{
-		EVAL_DEFINED_STATE_IDLE = 0,
-		EVAL_DEFINED_STATE_LOOKING
-	} state = EVAL_DEFINED_STATE_IDLE;
-
-	expression_token_t *et = NULL;
-	uint32_t level = 0;
-
-	// Process tokens
-	while (l != NULL)
-	{
-		// Get item from linked list node
-		et = LinkedListGetItem(l);
-
-		// Skip tokens other than defined operator
-		switch (state)
+		if (
+				(tt->type != CPARSER_TOKEN_TYPE_CPP_COMMENT) &&
+				(tt->type != CPARSER_TOKEN_TYPE_C_COMMENT) &&
+				(tt->type != CPARSER_TOKEN_TYPE_BACKSLASH)
+			)
 		{
+			TokenMaterialize(tt);
+			return true;
+		}
+	}
 
-		case EVAL_DEFINED_STATE_IDLE:
-			if (et->type == EXPRESSION_TOKEN_TYPE_DEFINED)
-			{
-				state = EVAL_DEFINED_STATE_LOOKING;
-			}
+	return false;
+}
 
-			// Move to next linked list node
-			l = LinkedListNext(l);
-			break;
+static bool ExpressionTokenIs(const token_t *tt, uint8_t c)
+{
+	return (tt->type == CPARSER_TOKEN_TYPE_SINGLE_CHAR) && (tt->str[0] == c);
+}
 
-		case EVAL_DEFINED_STATE_LOOKING:
-			if (et->type == EXPRESSION_TOKEN_TYPE_OPEN)
-			{
-				// Increase level
-				level++;
+static expression_value_t ComputeUnary(token_operator_t op, expression_value_t a)
+{
+	expression_value_t r = { 0, a.is_unsigned };
 
-				// Remove parenthesis
-				ExpressionTokenDelete(et);
-				l = LinkedListDelete(l);
-			}
-			else if (et->type == EXPRESSION_TOKEN_TYPE_IDENTIFIER)
-			{
-				// Store row and column identifier
-				uint32_t row = et->row;
-				uint32_t column = et->column;
+	// Negation wraps around like unsigned arithmetic instead of overflowing
+	switch (op)
+	{
 
-				// Replace previous define and definition identifier by a boolean decoded value
-				intptr_t value = DictionaryExistsKey(defines, et->data) ? 1 : 0;
-				cparserlinkedlist_t *defined = LinkedListPrevious(l);
+	case CPARSER_OPERATOR_LOGICAL_NOT:
+		r.value = !a.value;
+		r.is_unsigned = false;
+		break;
 
-				// Remove identifier
-				ExpressionTokenDelete(et);
-				l = LinkedListDelete(l);
+	case CPARSER_OPERATOR_BIT_NOT:
+		r.value = ~a.value;
+		break;
 
-				// Check and delete trailing close parenthesis
-				while ((l != NULL) && (level > 0))
-				{
-					et = LinkedListGetItem(l);
-					if (et->type != EXPRESSION_TOKEN_TYPE_CLOSE)
-						break;
+	case CPARSER_OPERATOR_ADD:
+		r.value = a.value;
+		break;
 
-					level--;
+	case CPARSER_OPERATOR_SUB:
+		r.value = (intmax_t)(0 - (uintmax_t)a.value);
+		break;
 
-					ExpressionTokenDelete(et);
-					l = LinkedListDelete(l);
-				}
+	default:
+		break;
 
-				// Update defined operator by removing previous expression token and creating a decoded value
-				if (level == 0)
-				{
-					// Get defined expression token and remove it
-					et = LinkedListGetItem(defined);
-					ExpressionTokenDelete(et);
-
-					// Set decoded value in former defined node
-					et = malloc(sizeof(expression_token_type_t));
-					et->type = EXPRESSION_TOKEN_TYPE_DECODED_VALUE;
-					et->row = row;
-					et->column = column;
-					et->data = (void *)value;
-					LinkedListUpdateItem(defined, et);
-
-					// Select next linked list token to defined
-					l = LinkedListNext(defined);
-
-					// Return to idle state
-					state = EVAL_DEFINED_STATE_IDLE;
-				}
-				else
-				{
-					// Syntax error: incorrect number of closing parenthesis
-					res->code = EXPRESSION_RESULT_ERROR_CLOSING_PARENTHESYS_DOES_NOT_MATCH;
-					res->value = 0;
-					res->row = et->row;
-					res->column = et->column;
-					return;
-				}
-			}
-			else
-			{
-				// Syntax error: defined operator syntax error
-				res->code = EXPRESSION_RESULT_ERROR_DEFINED_OPERATOR;
-				res->value = 0;
-				res->row = et->row;
-				res->column = et->column;
-				return;
-			}
-			break;
-
-		default:
-			res->code = EXPRESSION_RESULT_ERROR_DEFINED_EVAL;
-			res->value = 0;
-			res->row = et->row;
-			res->column = et->column;
-			return;
-			break;
-
-		}
 	}
 
-	res->code = EXPRESSION_RESULT_SUCCESS;
-	res->value = 0;
-	res->row = 0;
-	res->column = 0;
+	return r;
 }
 
-static void LinkedExpressionListReplaceDefinitions(cparserlinkedlist_t *l, cparserdictionary_t *defines, cparserexpression_result_t *res)
+static intmax_t ComputeShift(expression_value_t a, expression_value_t b, bool left)
 {
-	// Process tokens
-	while (l != NULL)
+	uintmax_t count = (uintmax_t)b.value;
+
+	// Negative counts shift the other way
+	if (!b.is_unsigned && (b.value < 0))
 	{
-		// Get item from linked list node
-		expression_token_t * et = LinkedListGetItem(l);
+		left = !left;
+		count = 0 - count;
+	}
 
-		if (et->type == EXPRESSION_TOKEN_TYPE_IDENTIFIER)
-		{
-			const object_t *oo = DictionaryGetKeyValue(defines, et->data);
-			intptr_t value = 0;
-			uint32_t row = et->row;
-			uint32_t column = et->column;
+	// Every bit is shifted out by counts as wide as the value, right shifts keep the sign
+	if (count >= EXPRESSION_VALUE_BITS)
+		return (!left && !a.is_unsigned && (a.value < 0)) ? -1 : 0;
 
-			// Try to find the preprocessor expression associated to the preprocessor identifier
-			if (oo != NULL)
-			{
-				if (oo->type == OBJECT_TYPE_PREPROCESSOR_EXPRESSION)
-				{
-					// Recursively evaluate the expression
-					ExpressionEvalPreprocessor(defines, oo->data, row, column, res);
+	if (left)
+		return (intmax_t)((uintmax_t)a.value << count);
 
-					// Check expression result
-					if (!res->code == EXPRESSION_RESULT_SUCCESS)
-						return;
+	return a.is_unsigned ? (intmax_t)((uintmax_t)a.value >> count) : a.value >> count;
+}
 
-					// Assign expression result value
-					value = res->value;
-				}
-				else if (oo->type == OBJECT_TYPE_PREPROCESSOR_IDENTIFIER)
-				{
-					// In this case oo should have a preprocessor expression sibbling
-					ObjectPrintRoot(_T "debug.log", oo);
-					__builtin_trap(); // TODO: implement looking for preprocessor expression sibbling
-				}
-				else
-				{
-					// No valid preprocessor expression can be found in dictionary
-					res->code = EXPRESSION_RESULT_ERROR_NO_VALID_PREPROCESSOR_EXPRESSION_FOUND;
-					res->value = 0;
-					res->row = et->row;
-					res->column = et->column;
-					return;
-				}
-			}
+static cparserexpression_result_code_t ComputeBinary(expression_value_t a, token_operator_t op, expression_value_t b, expression_value_t *res)
+{
+	uintmax_t ua = (uintmax_t)a.value;
+	uintmax_t ub = (uintmax_t)b.value;
+	expression_value_t r = { 0, a.is_unsigned || b.is_unsigned };		// Operands are unsigned if any of them is
 
-			// Replace current identifier expression token by a decoded value one
-			ExpressionTokenDelete(et);
-			et = malloc(sizeof(expression_token_t));
-			et->type = EXPRESSION_TOKEN_TYPE_DECODED_VALUE;
-			et->row = row;
-			et->column = column;
-			et->data = (void *)value;
-			LinkedListUpdateItem(l, et);
-		}
+	// Additions, subtractions and products wrap around in both signednesses
+	switch (op)
+	{
+
+	case CPARSER_OPERATOR_ADD:
+		r.value = (intmax_t)(ua + ub);
+		break;
+
+	case CPARSER_OPERATOR_SUB:
+		r.value = (intmax_t)(ua - ub);
+		break;
+
+	case CPARSER_OPERATOR_MUL:
+		r.value = (intmax_t)(ua * ub);
+		break;
+
+	// Divisions by zero and the only signed quotient out of range are errors
+	case CPARSER_OPERATOR_DIV:
+		if (ub == 0)
+			return EXPRESSION_RESULT_ERROR_DIVISION_BY_ZERO;
+		else if (!r.is_unsigned && (a.value == INTMAX_MIN) && (b.value == -1))
+			return EXPRESSION_RESULT_ERROR_OVERFLOW;
+		r.value = r.is_unsigned ? (intmax_t)(ua / ub) : a.value / b.value;
+		break;
+
+	case CPARSER_OPERATOR_MOD:
+		if (ub == 0)
+			return EXPRESSION_RESULT_ERROR_DIVISION_BY_ZERO;
+		else if (!r.is_unsigned && (b.value == -1))
+			r.value = 0;
+		else
+			r.value = r.is_unsigned ? (intmax_t)(ua % ub) : a.value % b.value;
+		break;
+
+	case CPARSER_OPERATOR_BIT_AND:
+		r.value = a.value & b.value;
+		break;
+
+	case CPARSER_OPERATOR_BIT_OR:
+		r.value = a.value | b.value;
+		break;
+
+	case CPARSER_OPERATOR_BIT_XOR:
+		r.value = a.value ^ b.value;
+		break;
+
+	// Shifts take the signedness of their left operand
+	case CPARSER_OPERATOR_SHIFT_LEFT:
+		r.value = ComputeShift(a, b, true);
+		r.is_unsigned = a.is_unsigned;
+		break;
+
+	case CPARSER_OPERATOR_SHIFT_RIGHT:
+		r.value = ComputeShift(a, b, false);
+		r.is_unsigned = a.is_unsigned;
+		break;
+
+	// Comparisons are signed
+	case CPARSER_OPERATOR_LESS:
+		r.value = r.is_unsigned ? (ua < ub) : (a.value < b.value);
+		r.is_unsigned = false;
+		break;
+
+	case CPARSER_OPERATOR_GREATER:
+		r.value = r.is_unsigned ? (ua > ub) : (a.value > b.value);
+		r.is_unsigned = false;
+		break;
+
+	case CPARSER_OPERATOR_LESS_EQUAL:
+		r.value = r.is_unsigned ? (ua <= ub) : (a.value <= b.value);
+		r.is_unsigned = false;
+		break;
+
+	case CPARSER_OPERATOR_GREATER_EQUAL:
+		r.value = r.is_unsigned ? (ua >= ub) : (a.value >= b.value);
+		r.is_unsigned = false;
+		break;
+
+	case CPARSER_OPERATOR_EQUAL:
+		r.value = (a.value == b.value);
+		r.is_unsigned = false;
+		break;
+
+	case CPARSER_OPERATOR_NOT_EQUAL:
+		r.value = (a.value != b.value);
+		r.is_unsigned = false;
+		break;
+
+	default:
+		break;
 
-		// Get next linked list item
-		l = LinkedListNext(l);
 	}
 
-	res->code = EXPRESSION_RESULT_SUCCESS;
-	res->value = 0;
-	res->row = 0;
-	res->column = 0;
-	return;
+	*res = r;
+
+	return EXPRESSION_RESULT_SUCCESS;
 }
 
-static intptr_t ComputeUnary(const uint8_t *op, intptr_t a)
+static bool ExpressionEmit(expression_compiler_t *ec, expression_opcode_t opcode, token_operator_t op, uint32_t row, uint32_t column, intmax_t value, bool is_unsigned)
 {
-	if ((op[0] == '!') && (op[1] == 0))
+	expression_code_t *code;
+
+	// Values pushed by the code shall fit in the evaluation stack
+	if (opcode <= EXPRESSION_OPCODE_DEFINED)
 	{
-		return !a;
+		if (ec->values_count == EXPRESSION_STACK_SIZE)
+			return false;
+		ec->values_count++;
 	}
-	else if ((op[0] == '~') && (op[1] == 0))
+	else if ((opcode == EXPRESSION_OPCODE_BINARY) || (opcode == EXPRESSION_OPCODE_JUMP_IF_FALSE) || (opcode == EXPRESSION_OPCODE_JUMP_IF_TRUE))
 	{
-		return ~a;
+		ec->values_count--;
 	}
-	else if ((op[0] == '+') && (op[1] == 0))
+
+	// Add code, growing codes array if it is full
+	if (ec->codes_count == ec->codes_size)
 	{
-		return +a;
+		ec->codes_size = ec->codes_size ? ec->codes_size * 2 : EXPRESSION_CODES_MIN_SIZE;
+		ec->codes = realloc(ec->codes, sizeof(expression_code_t) * ec->codes_size);
 	}
-	else if ((op[0] == '-') && (op[1] == 0))
+	code = &ec->codes[ec->codes_count++];
+	code->opcode = opcode;
+	code->op = op;
+	code->is_unsigned = is_unsigned;
+	code->row = row;
+	code->column = column;
+	code->value = value;
+
+	return true;
+}
+
+static atom_t ExpressionDepend(expression_compiler_t *ec, const token_t *tt)
+{
+	atom_t atom = AtomIntern(tt->slice, tt->length);
+
+	// Add atom to dependencies once
+	for (uint32_t i = 0; i < ec->depends_count; i++)
 	{
-		return -a;
+		if (ec->depends[i] == atom)
+			return atom;
 	}
-	else
+
+	if (ec->depends_count == ec->depends_size)
 	{
-		return 0;
+		ec->depends_size = ec->depends_size ? ec->depends_size * 2 : EXPRESSION_CODES_MIN_SIZE;
+		ec->depends = realloc(ec->depends, sizeof(atom_t) * ec->depends_size);
 	}
+	ec->depends[ec->depends_count++] = atom;
+
+	return atom;
 }
 
-static void LinkedExpressionListComputeUnary(cparserlinkedlist_t **list, cparserexpression_result_t *res)
+static void ExpressionReduce(expression_compiler_t *ec)
 {
-	cparserlinkedlist_t *l = *list;
+	// Emit the operator on top of the stack, its operands are already emitted
+	expression_operator_t *eo = &ec->operators[--ec->operators_count];
 
-	// Process tokens
-	while (l != NULL)
+	// Logical operators only normalize their right operand, the jump after the left one lands after it
+	if ((eo->op == CPARSER_OPERATOR_LOGICAL_AND) || (eo->op == CPARSER_OPERATOR_LOGICAL_OR))
 	{
-		// Update list with a valid node
-		*list = l;
+		ExpressionEmit(ec, EXPRESSION_OPCODE_LOGICAL, eo->op, eo->row, eo->column, 0, false);
+		ec->codes[eo->jump].value = ec->codes_count;
+		return;
+	}
 
-		// Get item from linked list node
-		expression_token_t * et = LinkedListGetItem(l);
-		cparserlinkedlist_t *prev = LinkedListPrevious(l);
-		cparserlinkedlist_t *prev_prev = LinkedListPrevious(prev);
-		expression_token_t *et_prev = LinkedListGetItem(prev);
-		expression_token_t *et_prev_prev = LinkedListGetItem(prev_prev);
+	ExpressionEmit(ec, (eo->precedence == EXPRESSION_PRECEDENCE_UNARY) ? EXPRESSION_OPCODE_UNARY : EXPRESSION_OPCODE_BINARY,
+			eo->op, eo->row, eo->column, 0, false);
+}
 
-		if (
-				// Value preceded by operator at the beginning of the expression
-				(
-					(et_prev != NULL) && (et_prev_prev == NULL) &&
-					(et->type == EXPRESSION_TOKEN_TYPE_DECODED_VALUE) &&
-					(et_prev->type == EXPRESSION_TOKEN_TYPE_OPERATOR)
-				)
-				||
-				// Value preceded by operator also preceded by operator
-				(
-					(et_prev != NULL) && (et_prev_prev != NULL) &&
-					(et->type == EXPRESSION_TOKEN_TYPE_DECODED_VALUE) &&
-					(et_prev->type == EXPRESSION_TOKEN_TYPE_OPERATOR) &&
-					(et_prev_prev->type == EXPRESSION_TOKEN_TYPE_OPERATOR)
-				)
-				||
-				// Value preceded by operator also preceded by open parenthesis
-				(
-					(et_prev != NULL) && (et_prev_prev != NULL) &&
-					(et->type == EXPRESSION_TOKEN_TYPE_DECODED_VALUE) &&
-					(et_prev->type == EXPRESSION_TOKEN_TYPE_OPERATOR) &&
-					(et_prev_prev->type == EXPRESSION_TOKEN_TYPE_OPEN)
-				)
-			)
-		{
-			// Unary operator before decoded value
-			if (!StringInAscendingSet(et_prev->data, valid_unary_operators, VALID_UNARY_OPERATORS_COUNT))
-			{
-				res->code = EXPRESSION_RESULT_ERROR_INVALID_UNARY_OPERATOR_IN_EXPRESSION;
-				res->value = 0;
-				res->row = et->row;
-				res->column = et->column;
-				return;
-			}
-			else if (
-					(et_prev_prev != NULL) && (et_prev_prev->type == EXPRESSION_TOKEN_TYPE_OPERATOR) &&
-					StrEq(et_prev_prev->data, "-") && StrEq(et_prev->data, "-")
-				)
-			{
-				res->code = EXPRESSION_RESULT_ERROR_MINUS_OPERATOR_CANNOT_BE_AFTER_ANOTHER_MINUS;
-				res->value = 0;
-				res->row = et->row;
-				res->column = et->column;
-				return;
-			}
-			else if (
-					(et_prev_prev != NULL) && (et_prev_prev->type == EXPRESSION_TOKEN_TYPE_OPERATOR) &&
-					StrEq(et_prev_prev->data, "+") && StrEq(et_prev->data, "+")
-				)
-			{
-				res->code = EXPRESSION_RESULT_ERROR_PLUS_OPERATOR_CANNOT_BE_AFTER_ANOTHER_PLUS;
-				res->value = 0;
-				res->row = et->row;
-				res->column = et->column;
-				return;
-			}
-			else
-			{
-				intptr_t value = ComputeUnary(et_prev->data, (intptr_t)et->data);
-				uint32_t row = et->row;
-				uint32_t column = et->column;
-
-				// Update current operand to value
-				ExpressionTokenDelete(et);
-				et = malloc(sizeof(expression_token_t));
-				et->type = EXPRESSION_TOKEN_TYPE_DECODED_VALUE;
-				et->row = row;
-				et->column = column;
-				et->data = (void *)value;
-				LinkedListUpdateItem(l, et);
-
-				// Remove previous operator
-				ExpressionTokenDelete(et_prev);
-				LinkedListDelete(prev);
-			}
-		}
-		else
-		{
-			// Select next token
-			l = LinkedListNext(l);
-		}
+static bool ExpressionPushOperator(expression_compiler_t *ec, const token_t *tt, uint8_t precedence, cparserexpression_result_t *res)
+{
+	expression_operator_t *eo;
+
+	if (ec->operators_count == EXPRESSION_STACK_SIZE)
+	{
+		// Expression too deep to be evaluated
+		ExpressionError(res, EXPRESSION_RESULT_ERROR_EXPRESSION_TOO_DEEP, tt->row, tt->column);
+		return false;
 	}
 
-	// Go to first token in list
-	*list = LinkedListFirst(*list);
+	eo = &ec->operators[ec->operators_count++];
+	eo->op = tt->op;
+	eo->precedence = precedence;
+	eo->jump = 0;
+	eo->row = tt->row;
+	eo->column = tt->column;
 
-	res->code = EXPRESSION_RESULT_SUCCESS;
-	res->value = 0;
-	res->row = 0;
-	res->column = 0;
+	return true;
 }
 
-static int OperatorPreference(const char *a, const char *b)
+static void ExpressionCompileDefined(expression_compiler_t *ec, token_t *tt, token_source_t *source, cparserexpression_result_t *res)
 {
-	if (StrEq(a, "*") || StrEq(a, "/") || StrEq(a, "%"))
-	{
-		return 1;
-	}
-	else if (StrEq(a, "+") || StrEq(a, "-"))
-	{
-		if (StrEq(b, "*") || StrEq(b, "/") || StrEq(b, "%"))
-		{
-			return -1;
-		}
-		else
-		{
-			return 1;
-		}
-	}
-	else if (StrEq(a, "<<") || StrEq(a, ">>"))
-	{
-		if (
-				StrEq(b, "*") || StrEq(b, "/") || StrEq(b, "%") ||
-				StrEq(b, "+") || StrEq(b, "-")
-			)
-		{
-			return -1;
-		}
-		else
-		{
-			return 1;
-		}
-	}
-	else if (StrEq(a, "<") || StrEq(a, "<=") || StrEq(a, ">") || StrEq(a, ">="))
-	{
-		if (
-				StrEq(b, "*") || StrEq(b, "/") || StrEq(b, "%") ||
-				StrEq(b, "+") || StrEq(b, "-") ||
-				StrEq(b, "<<") || StrEq(b, ">>")
-			)
-		{
-			return -1;
-		}
-		else
-		{
-			return 1;
-		}
-	}
-	else if (StrEq(a, "==") || StrEq(a, "!="))
-	{
-		if (
-				StrEq(b, "*") || StrEq(b, "/") || StrEq(b, "%") ||
-				StrEq(b, "+") || StrEq(b, "-") ||
-				StrEq(b, "<<") || StrEq(b, ">>") ||
-				StrEq(b, "<") || StrEq(b, "<=") || StrEq(b, ">") || StrEq(b, ">=")
-			)
-		{
-			return -1;
-		}
-		else
-		{
-			return 1;
-		}
-	}
-	else if (StrEq(a, "&"))
-	{
-		if (
-				StrEq(b, "*") || StrEq(b, "/") || StrEq(b, "%") ||
-				StrEq(b, "+") || StrEq(b, "-") ||
-				StrEq(b, "<<") || StrEq(b, ">>") ||
-				StrEq(b, "<") || StrEq(b, "<=") || StrEq(b, ">") || StrEq(b, ">=") ||
-				StrEq(b, "==") || StrEq(b, "!=")
-			)
-		{
-			return -1;
-		}
-		else
-		{
-			return 1;
-		}
-	}
-	else if (StrEq(a, "^"))
+	uint32_t row = tt->row;
+	uint32_t column = tt->column;
+	uint32_t level = 0;
+	bool more;
+
+	// Open parenthesis up to the identifier
+	while ((more = ExpressionNextToken(tt, source)) && ExpressionTokenIs(tt, '('))
+		level++;
+
+	if (!more)
 	{
-		if (
-				StrEq(b, "*") || StrEq(b, "/") || StrEq(b, "%") ||
-				StrEq(b, "+") || StrEq(b, "-") ||
-				StrEq(b, "<<") || StrEq(b, ">>") ||
-				StrEq(b, "<") || StrEq(b, "<=") || StrEq(b, ">") || StrEq(b, ">=") ||
-				StrEq(b, "==") || StrEq(b, "!=") ||
-				StrEq(b, "&")
-			)
-		{
-			return -1;
-		}
-		else
-		{
-			return 1;
-		}
+		// Syntax error: expression ends before the identifier
+		ExpressionError(res, EXPRESSION_RESULT_ERROR_DEFINED_WITHOUT_IDENTIFIER, row, column);
+		return;
 	}
-	else if (StrEq(a, "|"))
+	else if (tt->type != CPARSER_TOKEN_TYPE_IDENTIFIER)
 	{
-		if (
-				StrEq(b, "*") || StrEq(b, "/") || StrEq(b, "%") ||
-				StrEq(b, "+") || StrEq(b, "-") ||
-				StrEq(b, "<<") || StrEq(b, ">>") ||
-				StrEq(b, "<") || StrEq(b, "<=") || StrEq(b, ">") || StrEq(b, ">=") ||
-				StrEq(b, "==") || StrEq(b, "!=") ||
-				StrEq(b, "&") ||
-				StrEq(b, "^")
-			)
-		{
-			return -1;
-		}
-		else
-		{
-			return 1;
-		}
+		// Syntax error: defined operator followed by something else
+		ExpressionError(res, EXPRESSION_RESULT_ERROR_DEFINED_OPERATOR, tt->row, tt->column);
+		return;
 	}
-	else if (StrEq(a, "&&"))
+	else if (!ExpressionEmit(ec, EXPRESSION_OPCODE_DEFINED, CPARSER_OPERATOR_NONE, tt->row, tt->column, ExpressionDepend(ec, tt), false))
 	{
-		if (
-				StrEq(b, "*") || StrEq(b, "/") || StrEq(b, "%") ||
-				StrEq(b, "+") || StrEq(b, "-") ||
-				StrEq(b, "<<") || StrEq(b, ">>") ||
-				StrEq(b, "<") || StrEq(b, "<=") || StrEq(b, ">") || StrEq(b, ">=") ||
-				StrEq(b, "==") || StrEq(b, "!=") ||
-				StrEq(b, "&") ||
-				StrEq(b, "^") ||
-				StrEq(b, "|")
-			)
-		{
-			return -1;
-		}
-		else
-		{
-			return 1;
-		}
+		// Expression too deep to be evaluated
+		ExpressionError(res, EXPRESSION_RESULT_ERROR_EXPRESSION_TOO_DEEP, tt->row, tt->column);
+		return;
 	}
-	else if (StrEq(a, "||"))
+
+	// Close as many parenthesis as opened
+	for (; level > 0; level--)
 	{
-		if (
-				StrEq(b, "*") || StrEq(b, "/") || StrEq(b, "%") ||
-				StrEq(b, "+") || StrEq(b, "-") ||
-				StrEq(b, "<<") || StrEq(b, ">>") ||
-				StrEq(b, "<") || StrEq(b, "<=") || StrEq(b, ">") || StrEq(b, ">=") ||
-				StrEq(b, "==") || StrEq(b, "!=") ||
-				StrEq(b, "&") ||
-				StrEq(b, "^") ||
-				StrEq(b, "|") ||
-				StrEq(b, "&&")
-			)
+		if (!ExpressionNextToken(tt, source) || !ExpressionTokenIs(tt, ')'))
 		{
-			return -1;
-		}
-		else
-		{
-			return 1;
+			// Syntax error: incorrect number of closing parenthesis
+			ExpressionError(res, EXPRESSION_RESULT_ERROR_CLOSING_PARENTHESYS_DOES_NOT_MATCH, tt->row, tt->column);
+			return;
 		}
 	}
 
-	return 0;
+	res->code = EXPRESSION_RESULT_SUCCESS;
 }
 
-static intptr_t ComputeBinary(intptr_t a, const uint8_t *op, intptr_t b)
+static void ExpressionCompileTokens(expression_compiler_t *ec, const uint8_t *expression, cparserexpression_result_t *res)
 {
-	if ((op[0] == '+') && (op[1] == 0))
-	{
-		return a + b;
-	}
-	else if ((op[0] == '-') && (op[1] == 0))
-	{
-		return a - b;
-	}
-	else if ((op[0] == '*') && (op[1] == 0))
-	{
-		return a * b;
-	}
-	else if ((op[0] == '/') && (op[1] == 0))
-	{
-		return a / b;
-	}
-	else if ((op[0] == '%') && (op[1] == 0))
-	{
-		return a % b;
-	}
-	else if ((op[0] == '&') && (op[1] == 0))
-	{
-		return a & b;
-	}
-	else if ((op[0] == '|') && (op[1] == 0))
-	{
-		return a | b;
-	}
-	else if ((op[0] == '^') && (op[1] == 0))
-	{
-		return a ^ b;
-	}
-	else if ((op[0] == '<') && (op[1] == 0))
-	{
-		return a < b;
-	}
-	else if ((op[0] == '>') && (op[1] == 0))
-	{
-		return a > b;
-	}
-	else if ((op[0] == '&') && (op[1] == '&') && (op[2] == 0))
-	{
-		return a && b;
-	}
-	else if ((op[0] == '|') && (op[1] == '|') && (op[2] == 0))
-	{
-		return a || b;
-	}
-	else if ((op[0] == '<') && (op[1] == '<') && (op[2] == 0))
-	{
-		return a << b;
-	}
-	else if ((op[0] == '>') && (op[1] == '>') && (op[2] == 0))
-	{
-		return a >> b;
-	}
-	else if ((op[0] == '<') && (op[1] == '=') && (op[2] == 0))
-	{
-		return a <= b;
-	}
-	else if ((op[0] == '>') && (op[1] == '=') && (op[2] == 0))
-	{
-		return a >= b;
-	}
-	else if ((op[0] == '=') && (op[1] == '=') && (op[2] == 0))
-	{
-		return a == b;
-	}
-	else if ((op[0] == '!') && (op[1] == '=') && (op[2] == 0))
-	{
-		return a == b;
-	}
-	else
-	{
-		return 0;
-	}
-}
+	token_source_t source;
+	token_t tt;
+	bool operand = true;			// True when an operand is expected, false when an operator is
 
-static void LinkedExpressionListComputeBinary(cparserlinkedlist_t **list, cparserexpression_result_t *res)
-{
-	cparserlinkedlist_t *l = *list;
+	// Compile the expression in one pass, operators wait in the stack for operators with lower precedence
+	TokenInit(&tt);
+	TokenSourceInitMemory(&source, expression, strlen(_t expression));
+	res->code = EXPRESSION_RESULT_SUCCESS;
+	res->row = 0;
+	res->column = 0;
 
-	// Process tokens
-	while (l != NULL)
+	while ((res->code == EXPRESSION_RESULT_SUCCESS) && ExpressionNextToken(&tt, &source))
 	{
-		// Update list
-		*list = l;
-
-		// Get items from linked list node
-		expression_token_t *et = LinkedListGetItem(l);
+		if ((tt.type == CPARSER_TOKEN_TYPE_IDENTIFIER) || (tt.type == CPARSER_TOKEN_TYPE_NUMBER_LITERAL))
+		{
+			bool pushed;
 
-		cparserlinkedlist_t *prev = LinkedListPrevious(l);
-		cparserlinkedlist_t *next = LinkedListNext(l);
-		expression_token_t *et_prev = LinkedListGetItem(prev);
-		expression_token_t *et_next = LinkedListGetItem(next);
+			if (!operand)
+			{
+				// Operand after another operand, maybe in between parenthesis
+				ExpressionError(res, EXPRESSION_RESULT_ERROR_OPERAND_BESIDES_OPERAND, tt.row, tt.column);
+				break;
+			}
 
-		cparserlinkedlist_t *next_next = LinkedListNext(next);
-		expression_token_t *et_next_next = LinkedListGetItem(next_next);
+			// Emit operand, values of identifiers depend on definitions
+			if (tt.type == CPARSER_TOKEN_TYPE_NUMBER_LITERAL)
+			{
+				literal_integer_t li;
 
-		if (et->type == EXPRESSION_TOKEN_TYPE_DECODED_VALUE)
-		{
-			if (
-					((et_prev != NULL) && (et_prev->type == EXPRESSION_TOKEN_TYPE_CLOSE)) ||
-					((et_next != NULL) && (et_next->type == EXPRESSION_TOKEN_TYPE_OPEN))
-				)
+				if (!LiteralDecodeInteger(tt.slice, tt.length, &li))
+				{
+					// Floating, malformed or too large literal
+					ExpressionError(res, EXPRESSION_RESULT_ERROR_INVALID_NUMBER_LITERAL, tt.row, tt.column);
+					break;
+				}
+				pushed = ExpressionEmit(ec, EXPRESSION_OPCODE_VALUE, CPARSER_OPERATOR_NONE, tt.row, tt.column, (intmax_t)li.value, li.is_unsigned);
+			}
+			else if (tt.keyword == CPARSER_KEYWORD_DEFINED)
 			{
-				// Inverted parenthesis near operand
-				res->code = EXPRESSION_RESULT_ERROR_INVERTED_PARENTHESIS_NEAR_OPERAND;
-				res->value = 0;
-				res->row = (et_prev != NULL) ? et_prev->row : et_next->row;
-				res->column = (et_prev != NULL) ? et_prev->column : et_next->column;
-				return;
+				ExpressionCompileDefined(ec, &tt, &source, res);
+				pushed = true;
 			}
-			else if (
-					((et_prev != NULL) && (et_prev->type == EXPRESSION_TOKEN_TYPE_DECODED_VALUE)) ||
-					((et_next != NULL) && (et_next->type == EXPRESSION_TOKEN_TYPE_DECODED_VALUE))
-				)
+			else
 			{
-				// Illegal operand besides operand
-				res->code = EXPRESSION_RESULT_ERROR_OPERAND_BESIDES_OPERAND;
-				res->value = 0;
-				res->row = et->row;
-				res->column = et->column;
-				return;
+				pushed = ExpressionEmit(ec, EXPRESSION_OPCODE_DEFINITION, CPARSER_OPERATOR_NONE, tt.row, tt.column, ExpressionDepend(ec, &tt), false);
 			}
-			else if (
-					((et_prev == NULL) && (et_next != NULL) && (et_next->type == EXPRESSION_TOKEN_TYPE_CLOSE)) ||
-					((et_next == NULL) && (et_prev != NULL) && (et_prev->type == EXPRESSION_TOKEN_TYPE_OPEN))
-				)
+
+			if (!pushed)
 			{
-				// Illegal operand with partial parenthesis
-				res->code = EXPRESSION_RESULT_ERROR_INCORRECT_PARENTHESIS;
-				res->value = 0;
-				res->row = (et_prev != NULL) ? et_prev->row : et_next->row;
-				res->column = (et_prev != NULL) ? et_prev->column : et_next->column;
-				return;
+				// Expression too deep to be evaluated
+				ExpressionError(res, EXPRESSION_RESULT_ERROR_EXPRESSION_TOO_DEEP, tt.row, tt.column);
+				break;
 			}
-			else if (
-					((et_prev != NULL) && (et_prev->type == EXPRESSION_TOKEN_TYPE_OPEN)) &&
-					((et_next != NULL) && (et_next->type == EXPRESSION_TOKEN_TYPE_CLOSE))
-				)
+			operand = false;
+		}
+		else if (ExpressionTokenIs(&tt, '('))
+		{
+			if (!operand)
 			{
-				// Operand is alone in between parenthesis, so remove them
-				ExpressionTokenDelete(et_next);
-				ExpressionTokenDelete(et_prev);
-				LinkedListDelete(next);
-				LinkedListDelete(prev);
+				// Open parenthesis after an operand
+				ExpressionError(res, EXPRESSION_RESULT_ERROR_INVERTED_PARENTHESIS_NEAR_OPERAND, tt.row, tt.column);
+				break;
 			}
+
+			ExpressionPushOperator(ec, &tt, EXPRESSION_PRECEDENCE_NONE, res);
 		}
-		else if (et->type == EXPRESSION_TOKEN_TYPE_OPERATOR)
+		else if (ExpressionTokenIs(&tt, ')'))
 		{
-			if ((et_prev == NULL) || (et_next == NULL))
+			// Reduce up to the open parenthesis
+			while ((ec->operators_count > 0) && (ec->operators[ec->operators_count - 1].precedence != EXPRESSION_PRECEDENCE_NONE) && !operand)
+				ExpressionReduce(ec);
+
+			if (operand || (ec->operators_count == 0))
 			{
-				// Operator without operand
-				res->code = EXPRESSION_RESULT_ERROR_OPERATOR_WITH_NO_OPERANDS;
-				res->value = 0;
-				res->row = et->row;
-				res->column = et->column;
-				return;
+				// Close parenthesis without operand before or without open parenthesis
+				ExpressionError(res, EXPRESSION_RESULT_ERROR_INCORRECT_PARENTHESIS, tt.row, tt.column);
+				break;
 			}
-			else if (
-					((et_prev != NULL) && (et_prev->type == EXPRESSION_TOKEN_TYPE_OPEN)) ||
-					((et_next != NULL) && (et_next->type == EXPRESSION_TOKEN_TYPE_CLOSE))
-				)
+
+			ec->operators_count--;
+		}
+		else if ((tt.type == CPARSER_TOKEN_TYPE_OPERATOR) && (operator_classes[tt.op].unary || (operator_classes[tt.op].precedence != EXPRESSION_PRECEDENCE_NONE)))
+		{
+			const expression_operator_class_t *oc = &operator_classes[tt.op];
+
+			if (operand)
 			{
-				// Operator with incorrect parenthesys around (notify parenthesis node)
-				res->code = EXPRESSION_RESULT_ERROR_INCORRECT_PARENTHESIS;
-				res->value = 0;
-				res->row = (et_prev != NULL) ? et_prev->row : et_next->row;
-				res->column = (et_prev != NULL) ? et_prev->column : et_next->column;
-				return;
+				expression_operator_t *top = ec->operators_count ? &ec->operators[ec->operators_count - 1] : NULL;
+
+				// Unary operator before its operand
+				if (!oc->unary)
+				{
+					ExpressionError(res, EXPRESSION_RESULT_ERROR_INVALID_UNARY_OPERATOR_IN_EXPRESSION, tt.row, tt.column);
+					break;
+				}
+				else if ((top != NULL) && (top->precedence == EXPRESSION_PRECEDENCE_UNARY) && (top->op == CPARSER_OPERATOR_SUB) && (tt.op == CPARSER_OPERATOR_SUB))
+				{
+					ExpressionError(res, EXPRESSION_RESULT_ERROR_MINUS_OPERATOR_CANNOT_BE_AFTER_ANOTHER_MINUS, tt.row, tt.column);
+					break;
+				}
+				else if ((top != NULL) && (top->precedence == EXPRESSION_PRECEDENCE_UNARY) && (top->op == CPARSER_OPERATOR_ADD) && (tt.op == CPARSER_OPERATOR_ADD))
+				{
+					ExpressionError(res, EXPRESSION_RESULT_ERROR_PLUS_OPERATOR_CANNOT_BE_AFTER_ANOTHER_PLUS, tt.row, tt.column);
+					break;
+				}
+
+				ExpressionPushOperator(ec, &tt, EXPRESSION_PRECEDENCE_UNARY, res);
 			}
-			else if (
-					((et_prev != NULL) && (et_prev->type != EXPRESSION_TOKEN_TYPE_CLOSE) && (et_prev->type != EXPRESSION_TOKEN_TYPE_DECODED_VALUE)) ||
-					((et_next != NULL) && (et_next->type != EXPRESSION_TOKEN_TYPE_OPEN) && (et_next->type != EXPRESSION_TOKEN_TYPE_DECODED_VALUE))
-				)
+			else if (oc->precedence == EXPRESSION_PRECEDENCE_NONE)
 			{
-				// Operator lacks of valid operands or parenthesis arround
-				res->code = EXPRESSION_RESULT_ERROR_OPERATOR_WITH_INVALID_NEIGHBOURS;
-				res->value = 0;
-				res->row = (et_prev != NULL) ? et_prev->row : et_next->row;
-				res->column = (et_prev != NULL) ? et_prev->column : et_next->column;
-				return;
+				// Unary only operator after an operand
+				ExpressionError(res, EXPRESSION_RESULT_ERROR_OPERATOR_WITH_INVALID_NEIGHBOURS, tt.row, tt.column);
+				break;
 			}
-			else if (
-					((et_prev != NULL) && (et_prev->type == EXPRESSION_TOKEN_TYPE_DECODED_VALUE)) &&
-					((et_next != NULL) && (et_next->type == EXPRESSION_TOKEN_TYPE_DECODED_VALUE))
-				)
+			else
 			{
-				if (
-						// No next operator so no precedence checking
-						(et_next_next == NULL)
-						||
-						// Close parenthesis so no precedence checking
-						(
-							(et_next_next != NULL) &&
-							(et_next_next->type == EXPRESSION_TOKEN_TYPE_CLOSE))
-						||
-						// There is a operator next so check operator precedence
-						(
-							(et_next_next != NULL) &&
-							(et_next_next->type == EXPRESSION_TOKEN_TYPE_OPERATOR) &&
-							OperatorPreference(et->data, et_next_next->data) >= 0
-						)
-					)
+				// Reduce the operators binding as tight or tighter, binary operators are left associative
+				while ((ec->operators_count > 0) && (ec->operators[ec->operators_count - 1].precedence >= oc->precedence))
+					ExpressionReduce(ec);
+
+				// Logical operators skip their right operand when the left one decides the result
+				if ((tt.op == CPARSER_OPERATOR_LOGICAL_AND) || (tt.op == CPARSER_OPERATOR_LOGICAL_OR))
 				{
-					// Perform operation
-					intptr_t value = ComputeBinary((intptr_t)et_prev->data, et->data, (intptr_t)et_next->data);
-					uint32_t row = et->row;
-					uint32_t column = et->column;
-
-					// Replace current by value
-					ExpressionTokenDelete(et);
-					et = malloc(sizeof(expression_token_t));
-					et->type = EXPRESSION_TOKEN_TYPE_DECODED_VALUE;
-					et->row = row;
-					et->column = column;
-					et->data = (void *)value;
-					LinkedListUpdateItem(l, et);
-
-					// Delete prev and next
-					ExpressionTokenDelete(et_prev);
-					ExpressionTokenDelete(et_next);
-					LinkedListDelete(prev);
-					LinkedListDelete(next);
+					uint32_t jump = ec->codes_count;
+
+					ExpressionEmit(ec, (tt.op == CPARSER_OPERATOR_LOGICAL_AND) ? EXPRESSION_OPCODE_JUMP_IF_FALSE : EXPRESSION_OPCODE_JUMP_IF_TRUE,
+							tt.op, tt.row, tt.column, 0, false);
+					if (ExpressionPushOperator(ec, &tt, oc->precedence, res))
+						ec->operators[ec->operators_count - 1].jump = jump;
 				}
+				else
+				{
+					ExpressionPushOperator(ec, &tt, oc->precedence, res);
+				}
+				operand = true;
 			}
 		}
+		else
+		{
+			ExpressionError(res, EXPRESSION_RESULT_ERROR_INCORRECT_TOKEN, tt.row, tt.column);
+		}
+	}
+
+	TokenRelease(&tt);
+
+	if (res->code != EXPRESSION_RESULT_SUCCESS)
+		return;
+
+	if (operand)
+	{
+		if (ec->codes_count == 0 && ec->operators_count == 0)
+		{
+			// Error: empty expression
+			ExpressionError(res, EXPRESSION_RESULT_ERROR_LAST_EXPRESSION_TOKEN_SHALL_BE_A_DECODED_VALUE, 0, 0);
+		}
+		else
+		{
+			expression_operator_t *top = &ec->operators[ec->operators_count - 1];
 
-		l = LinkedListNext(l);
+			// Error: operator or open parenthesis at the end of the expression
+			ExpressionError(res,
+					(top->precedence == EXPRESSION_PRECEDENCE_NONE) ? EXPRESSION_RESULT_ERROR_INCORRECT_PARENTHESIS : EXPRESSION_RESULT_ERROR_OPERATOR_WITH_NO_OPERANDS,
+					top->row, top->column);
+		}
+		return;
 	}
 
-	// Go to first token in list
-	*list = LinkedListFirst(*list);
+	// Reduce remaining operators
+	while ((ec->operators_count > 0) && (ec->operators[ec->operators_count - 1].precedence != EXPRESSION_PRECEDENCE_NONE))
+		ExpressionReduce(ec);
 
-	res->code = EXPRESSION_RESULT_SUCCESS;
-	res->value = 0;
-	res->row = 0;
-	res->column = 0;
+	if (ec->operators_count > 0)
+	{
+		// Error: open parenthesis never closed
+		ExpressionError(res, EXPRESSION_RESULT_ERROR_INCORRECT_PARENTHESIS,
+				ec->operators[ec->operators_count - 1].row, ec->operators[ec->operators_count - 1].column);
+	}
 }
 
-static void ExpressionToLinkedList(const uint8_t *expression, uint32_t row, uint32_t column, cparserlinkedlist_t **list, cparserexpression_result_t *res)
+static expression_bytecode_t *ExpressionCompile(const uint8_t *expression, uint32_t length, uint32_t hash)
 {
-	token_t *tt = TokenNew();
-	token_source_t source;
-	cparserlinkedlist_t *l = NULL;
-	expression_token_t *et = NULL;
+	expression_compiler_t ec;
+	cparserexpression_result_t res;
+	expression_bytecode_t *bc;
+
+	ec.operators_count = 0;
+	ec.values_count = 0;
+	ec.codes = NULL;
+	ec.codes_size = 0;
+	ec.codes_count = 0;
+	ec.depends = NULL;
+	ec.depends_size = 0;
+	ec.depends_count = 0;
+
+	ExpressionCompileTokens(&ec, expression, &res);
+
+	// Syntax errors are kept in place of the codes
+	if (res.code != EXPRESSION_RESULT_SUCCESS)
+	{
+		ec.codes_count = 0;
+		ec.depends_count = 0;
+	}
 
-	// Initialize result
-	res->code = EXPRESSION_RESULT_SUCCESS;
-	res->value = 0;
-	res->row = 0;
-	res->column = 0;
+	// Pack codes, dependencies and text in one block
+	bc = malloc(sizeof(expression_bytecode_t) + sizeof(expression_code_t) * ec.codes_count + sizeof(atom_t) * ec.depends_count + length + 1);
+	bc->code = res.code;
+	bc->row = res.row;
+	bc->column = res.column;
+	bc->codes_count = ec.codes_count;
+	bc->depends_count = ec.depends_count;
+	bc->depends = (atom_t *)&bc->codes[ec.codes_count];
+	if (ec.codes_count > 0)
+		memcpy(bc->codes, ec.codes, sizeof(expression_code_t) * ec.codes_count);
+	if (ec.depends_count > 0)
+		memcpy(bc->depends, ec.depends, sizeof(atom_t) * ec.depends_count);
+	bc->text = (const uint8_t *)&bc->depends[ec.depends_count];
+	bc->length = length;
+	bc->hash = hash;
+	memcpy((uint8_t *)bc->text, expression, length + 1);
+
+	free(ec.codes);
+	free(ec.depends);
+
+	return bc;
+}
 
-	// Initialize token source
-	TokenSourceInit(&source, &expression, GetNextChar);
+static void ExpressionRun(cparserexpression_cache_t *cache, cparserdictionary_t *defines, const expression_bytecode_t *bc, cparserexpression_result_t *res, bool *cacheable)
+{
+	expression_value_t values[EXPRESSION_STACK_SIZE];
+	uint32_t count = 0;
+
+	if (bc->code != EXPRESSION_RESULT_SUCCESS)
+	{
+		ExpressionError(res, bc->code, bc->row, bc->column);
+		return;
+	}
 
-	// Parse tokens into linked list
-	while ((res->code == EXPRESSION_RESULT_SUCCESS) && TokenNext(tt, &source, 0))
+	// Run codes, compilation checked the operands of every operator
+	for (uint32_t i = 0; i < bc->codes_count; i++)
 	{
-		// Skip
-		if ((tt->type == CPARSER_TOKEN_TYPE_CPP_COMMENT) || (tt->type == CPARSER_TOKEN_TYPE_C_COMMENT))
-			continue;
+		const expression_code_t *code = &bc->codes[i];
 
-		if (tt->type == CPARSER_TOKEN_TYPE_IDENTIFIER)
+		switch (code->opcode)
 		{
-			et = malloc(sizeof(expression_token_t));
 
-			if (StrEq("defined", _t tt->str))
+		case EXPRESSION_OPCODE_VALUE:
+			values[count].value = code->value;
+			values[count++].is_unsigned = code->is_unsigned;
+			break;
+
+		case EXPRESSION_OPCODE_DEFINITION:
+			values[count++] = ExpressionEvalDefinition(cache, defines, code->value, code->row, code->column, res, cacheable);
+			if (res->code != EXPRESSION_RESULT_SUCCESS)
+				return;
+			break;
+
+		case EXPRESSION_OPCODE_DEFINED:
+			values[count].value = DictionaryExistsAtom(defines, code->value) ? 1 : 0;
+			values[count++].is_unsigned = false;
+			break;
+
+		case EXPRESSION_OPCODE_UNARY:
+			values[count - 1] = ComputeUnary(code->op, values[count - 1]);
+			break;
+
+		case EXPRESSION_OPCODE_BINARY:
+			count--;
+			res->code = ComputeBinary(values[count - 1], code->op, values[count], &values[count - 1]);
+			if (res->code != EXPRESSION_RESULT_SUCCESS)
+			{
+				// Arithmetic error at the operator
+				ExpressionError(res, res->code, code->row, code->column);
+				return;
+			}
+			break;
+
+		case EXPRESSION_OPCODE_JUMP_IF_FALSE:
+		case EXPRESSION_OPCODE_JUMP_IF_TRUE:
+			if ((values[count - 1].value != 0) == (code->opcode == EXPRESSION_OPCODE_JUMP_IF_TRUE))
 			{
-				et->type = EXPRESSION_TOKEN_TYPE_DEFINED;
-				et->row = tt->row;
-				et->column = tt->column;
-				et->data = NULL;
+				// Left operand decides the result, right operand is not evaluated
+				values[count - 1].value = (code->opcode == EXPRESSION_OPCODE_JUMP_IF_TRUE);
+				values[count - 1].is_unsigned = false;
+				i = (uint32_t)code->value - 1;
 			}
 			else
 			{
-				et->type = EXPRESSION_TOKEN_TYPE_IDENTIFIER;
-				et->row = tt->row;
-				et->column = tt->column;
-				et->data = strdup(_t tt->str);
+				count--;
 			}
-		}
-		else if ((tt->type == CPARSER_TOKEN_TYPE_SINGLE_CHAR) && ((tt->str[0] == '(') || (tt->str[0] == ')')))
-		{
-			et = malloc(sizeof(expression_token_t));
-			et->type = tt->str[0] == '(' ? EXPRESSION_TOKEN_TYPE_OPEN : EXPRESSION_TOKEN_TYPE_CLOSE;
-			et->row = tt->row;
-			et->column = tt->column;
-			et->data = NULL;
-		}
-		else if ((tt->type == CPARSER_TOKEN_TYPE_OPERATOR) && StringInAscendingSet(tt->str, valid_operators, VALID_OPERATORS_COUNT))
-		{
-			et = malloc(sizeof(expression_token_t));
-			et->type = EXPRESSION_TOKEN_TYPE_OPERATOR;
-			et->row = tt->row;
-			et->column = tt->column;
-			et->data = strdup(_t tt->str);
-		}
-		else if (tt->type == CPARSER_TOKEN_TYPE_NUMBER_LITERAL)
-		{
-			et = malloc(sizeof(expression_token_t));
-			et->type = EXPRESSION_TOKEN_TYPE_DECODED_VALUE;
-			et->row = tt->row;
-			et->column = tt->column;
-			et->data = (void *)atoll(_t tt->str);
-		}
-		else if (tt->type == CPARSER_TOKEN_TYPE_BACKSLASH)
-		{
-			/* Do not add backslash */
-			continue;
-		}
-		else
-		{
-			res->code = EXPRESSION_RESULT_ERROR_INCORRECT_TOKEN;
-			res->value = 0;
-			res->row = tt->row;
-			res->column = tt->column;
 			break;
-		}
 
-		// Add expression token to list
-		if (l == NULL)
-		{
-			l = LinkedListNew(et);
-		}
-		else
-		{
-			l = LinkedListInsertAfter(l, et);
+		case EXPRESSION_OPCODE_LOGICAL:
+			values[count - 1].value = (values[count - 1].value != 0);
+			values[count - 1].is_unsigned = false;
+			break;
+
+		default:
+			break;
+
 		}
 	}
 
-	// Destroy allocated token buffer
-	TokenDelete(tt);
+	res->code = EXPRESSION_RESULT_SUCCESS;
+	res->value = values[0].value;
+	res->is_unsigned = values[0].is_unsigned;
+}
+
+static uint32_t ExpressionHash(const uint8_t *s, uint32_t length)
+{
+	uint32_t h = EXPRESSION_FNV_OFFSET;
+
+	for (uint32_t i = 0; i < length; i++)
+		h = (h ^ s[i]) * EXPRESSION_FNV_PRIME;
 
-	// Assign the decoded list to l
-	*list = LinkedListFirst(l);
+	return h;
 }
 
-void ExpressionEvalPreprocessor(cparserdictionary_t *defines, const uint8_t *expression, uint32_t row, uint32_t column, cparserexpression_result_t *res)
+static uint32_t ExpressionCacheSlot(const cparserexpression_cache_t *cache, const uint8_t *expression, uint32_t length, uint32_t h)
 {
-	cparserlinkedlist_t *list;
+	uint32_t mask = cache->slots_size - 1;
+	uint32_t i = h & mask;
 
-	ExpressionToLinkedList(expression, row, column, &list, res);
-	LinkedExpressionListPrint(list);
-	if (res->code != EXPRESSION_RESULT_SUCCESS)
+	// Linear probing up to the expression or an empty slot
+	while (cache->slots[i] != NULL)
 	{
-		LinkedExpressionListDelete(list);
-		return;
-	}
+		const expression_bytecode_t *bc = cache->slots[i];
 
-	// Compute defined operator and print
-	LinkedExpressionListComputeDefined(list, defines, res);
-	LinkedExpressionListPrint(list);
-	if (res->code != EXPRESSION_RESULT_SUCCESS)
-	{
-		LinkedExpressionListDelete(list);
-		return;
-	}
+		if (bc->hash == h && bc->length == length && memcmp(bc->text, expression, length) == 0)
+			break;
 
-	// Replace definitions and print
-	LinkedExpressionListReplaceDefinitions(list, defines, res);
-	LinkedExpressionListPrint(list);
-	if (res->code != EXPRESSION_RESULT_SUCCESS)
-	{
-		LinkedExpressionListDelete(list);
-		return;
+		i = (i + 1) & mask;
 	}
 
-	// Compute unary operators and print
-	LinkedExpressionListComputeUnary(&list, res);
-	LinkedExpressionListPrint(list);
-	if (res->code != EXPRESSION_RESULT_SUCCESS)
-	{
-		LinkedExpressionListDelete(list);
-		return;
-	}
+	return i;
+}
+
+static void ExpressionCacheGrow(cparserexpression_cache_t *cache)
+{
+	expression_bytecode_t **old = cache->slots;
+	uint32_t old_size = cache->slots_size;
 
-	// Compute expression evaluator and print
-	while (LinkedListNext(list) != NULL)
+	// Double the slots and rehash compiled expressions
+	cache->slots_size = (old_size == 0) ? EXPRESSION_CACHE_MIN_SIZE : old_size * 2;
+	cache->slots = calloc(cache->slots_size, sizeof(expression_bytecode_t *));
+	for (uint32_t i = 0; i < old_size; i++)
 	{
-		LinkedExpressionListComputeBinary(&list, res);
-		LinkedExpressionListPrint(list);
-		if (res->code != EXPRESSION_RESULT_SUCCESS)
+		expression_bytecode_t *bc = old[i];
+
+		if (bc != NULL)
 		{
-			LinkedExpressionListDelete(list);
-			return;
+			uint32_t j = bc->hash & (cache->slots_size - 1);
+
+			while (cache->slots[j] != NULL)
+				j = (j + 1) & (cache->slots_size - 1);
+			cache->slots[j] = bc;
 		}
 	}
+	free(old);
+}
+
+static const expression_bytecode_t *ExpressionCacheGet(cparserexpression_cache_t *cache, const uint8_t *expression)
+{
+	uint32_t length = strlen(_t expression);
+	uint32_t h = ExpressionHash(expression, length);
+	uint32_t i;
 
-	// Take last expression token
-	expression_token_t *et = LinkedListGetItem(list);
+	if (cache->count * 2 >= cache->slots_size)
+		ExpressionCacheGrow(cache);
 
-	// Check expression token is decoded value
-	if (et->type != EXPRESSION_TOKEN_TYPE_DECODED_VALUE)
+	// Compile each expression text once
+	i = ExpressionCacheSlot(cache, expression, length, h);
+	if (cache->slots[i] == NULL)
 	{
-		// Error: last expression token type shall be decoded value
-		res->code = EXPRESSION_RESULT_ERROR_LAST_EXPRESSION_TOKEN_SHALL_BE_A_DECODED_VALUE;
-		res->value = 0;
+		cache->slots[i] = ExpressionCompile(expression, length, h);
+		cache->count++;
 	}
-	else
+
+	return cache->slots[i];
+}
+
+static void ExpressionEval(cparserexpression_cache_t *cache, cparserdictionary_t *defines, const uint8_t *expression, uint32_t row, uint32_t column,
+		cparserexpression_result_t *res, const expression_bytecode_t **bytecode, bool *cacheable)
+{
+	const expression_bytecode_t *bc = ExpressionCacheGet(cache, expression);
+
+	*bytecode = bc;
+
+	// Results and errors without position are placed at the expression
+	ExpressionRun(cache, defines, bc, res, cacheable);
+	if ((res->code == EXPRESSION_RESULT_SUCCESS) || ((res->row == 0) && (res->column == 0)))
 	{
-		// Set code depending on token value
-		res->code = EXPRESSION_RESULT_SUCCESS;
-		res->value = (intptr_t)et->data;
+		res->row = row;
+		res->column = column;
 	}
-	res->row = row;
-	res->column = column;
+}
 
-	// Free list
-	LinkedExpressionListDelete(list);
+/**
+ * Creates an empty cache of compiled expressions
+ *
+ * Expressions are compiled once per cache and evaluated with the definitions given to each evaluation.
+ * The cache is not thread safe, give each parser its own.
+ *
+ * \return new expression cache
+ */
+cparserexpression_cache_t *ExpressionCacheNew(void)
+{
+	cparserexpression_cache_t *cache = malloc(sizeof(cparserexpression_cache_t));
+
+	cache->slots = NULL;
+	cache->slots_size = 0;
+	cache->count = 0;
+
+	return cache;
 }
 
+void ExpressionCacheDelete(cparserexpression_cache_t *cache)
+{
+	if (cache == NULL)
+		return;
+
+	for (uint32_t i = 0; i < cache->slots_size; i++)
+		free(cache->slots[i]);
+	free(cache->slots);
+	free(cache);
+}
+
+void ExpressionEvalPreprocessor(cparserexpression_cache_t *cache, cparserdictionary_t *defines, const uint8_t *expression, uint32_t row, uint32_t column, cparserexpression_result_t *res)
+{
+	const expression_bytecode_t *bc;
+	bool cacheable;
+
+	ExpressionEval(cache, defines, expression, row, column, res, &bc, &cacheable);
+}
 
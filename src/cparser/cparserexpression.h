@@ -25,18 +25,28 @@ typedef enum cparserexpression_result_code_e
 	EXPRESSION_RESULT_ERROR_OPERATOR_WITH_INVALID_NEIGHBOURS,
 	EXPRESSION_RESULT_ERROR_OPERATOR_WITH_NO_OPERANDS,
 	EXPRESSION_RESULT_ERROR_LAST_EXPRESSION_TOKEN_SHALL_BE_A_DECODED_VALUE,
-	EXPRESSION_RESULT_ERROR_NO_VALID_PREPROCESSOR_EXPRESSION_FOUND
+	EXPRESSION_RESULT_ERROR_NO_VALID_PREPROCESSOR_EXPRESSION_FOUND,
+	EXPRESSION_RESULT_ERROR_INVALID_NUMBER_LITERAL,
+	EXPRESSION_RESULT_ERROR_EXPRESSION_TOO_DEEP,
+	EXPRESSION_RESULT_ERROR_DIVISION_BY_ZERO,
+	EXPRESSION_RESULT_ERROR_OVERFLOW
 } cparserexpression_result_code_t;
 
 typedef struct cparserexpression_result_e
 {
 	cparserexpression_result_code_t code;
-	intptr_t value;
+	intmax_t value;
+	bool is_unsigned;			// Value is uintmax_t
 	uint32_t row;
 	uint32_t column;
 } cparserexpression_result_t;
 
-void ExpressionEvalPreprocessor(cparserdictionary_t *defines, const uint8_t *expression, uint32_t row, uint32_t column, cparserexpression_result_t *res);
+// Compiled expressions by expression text
+typedef struct cparserexpression_cache_s cparserexpression_cache_t;
+
+cparserexpression_cache_t *ExpressionCacheNew(void);
+void ExpressionCacheDelete(cparserexpression_cache_t *cache);
+void ExpressionEvalPreprocessor(cparserexpression_cache_t *cache, cparserdictionary_t *defines, const uint8_t *expression, uint32_t row, uint32_t column, cparserexpression_result_t *res);
 
 
 #endif /* CPARSEREXPRESSION_H_ */
@@ -0,0 +1,443 @@
+/*
+ * cparserfile.c
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "cparsertools.h"
+#include "cparsertoken.h"
+#include "cparserkeyword.h"
+#include "cparseratom.h"
+#include "cparsertokenstream.h"
+#include "cparserlines.h"
+#include "cparserfile.h"
+
+
+#define FILE_READ_BLOCK_SIZE		(1 << 16)				// 64 Kb
+#define FILE_CACHE_BUDGET			((size_t)256 << 20)		// 256 Mb of cached contents
+#define FILE_CACHE_MIN_BUCKETS		256
+
+
+struct cparserfile_s
+{
+	uint8_t *data;			// File contents
+	size_t size;			// File contents size
+	bool mapped;			// True if data is memory mapped, false if it was read into a heap buffer
+	bool cached;			// True while it is in the cache, files that are not regular never are
+	uint32_t refs;			// Users of the contents, unreferenced cached files wait in the LRU list
+	cparsertokenstream_t *stream;	// Tokens of the contents, NULL until first parsed
+	cparserlines_t *lines;			// Line index of the contents, NULL until a position is needed
+
+	dev_t dev;				// Cache key, a file changes when its modification time or size do
+	ino_t ino;
+	struct timespec mtime;
+	off_t st_size;
+
+	struct cparserfile_s *next;			// Next file in the same cache bucket
+	struct cparserfile_s *lru_prev;		// Unreferenced files, most recently released first
+	struct cparserfile_s *lru_next;
+};
+
+// Contents of the files read by every parser, they are read once while they fit the budget
+typedef struct file_cache_s
+{
+	cparserfile_t **buckets;	// Files chained by device and inode hash
+	uint32_t buckets_size;		// Buckets count, power of two
+	uint32_t count;				// Cached files count
+	size_t size;				// Cached contents size, referenced or not
+	size_t budget;				// Unreferenced files are evicted while size is over it
+	cparserfile_t *lru_head;	// Most recently released file
+	cparserfile_t *lru_tail;	// Least recently released file, evicted first
+} file_cache_t;
+
+
+// File cache is shared by all parsers, use it only from the parser thread like atoms
+static file_cache_t file_cache = { NULL, 0, 0, 0, FILE_CACHE_BUDGET, NULL, NULL };
+
+
+static bool FileMap(cparserfile_t *res, int fd, const struct stat *st)
+{
+	void *data;
+
+	// Only non empty regular files can be mapped
+	if (!S_ISREG(st->st_mode) || st->st_size <= 0)
+		return false;
+
+	data = mmap(NULL, st->st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED)
+		return false;
+
+	// Tokenizer walks the file from the beginning to the end
+	madvise(data, st->st_size, MADV_SEQUENTIAL);
+
+	res->data = data;
+	res->size = st->st_size;
+	res->mapped = true;
+
+	return true;
+}
+
+static bool FileRead(cparserfile_t *res, int fd)
+{
+	size_t size = 0;
+	ssize_t r;
+
+	// Read the whole stream (pipes, terminals, ...) into a growing buffer
+	res->data = NULL;
+	res->size = 0;
+	res->mapped = false;
+
+	do
+	{
+		// Increase buffer if full
+		if (res->size == size)
+		{
+			uint8_t *data = realloc(res->data, size + FILE_READ_BLOCK_SIZE);
+
+			// Out of memory, contents would be incomplete
+			if (data == NULL)
+			{
+				r = -1;
+				break;
+			}
+			res->data = data;
+			size += FILE_READ_BLOCK_SIZE;
+		}
+
+		r = read(fd, res->data + res->size, size - res->size);
+		if (r > 0)
+			res->size += r;
+	}
+	while ((r > 0) || ((r < 0) && (errno == EINTR)));
+
+	// Contents are complete only if the end of the stream is reached
+	if (r != 0)
+	{
+		free(res->data);
+		res->data = NULL;
+		res->size = 0;
+		return false;
+	}
+
+	return true;
+}
+
+static void FileRelease(cparserfile_t *f)
+{
+	// Release tokens and line index built from the contents
+	if (f->stream != NULL)
+		TokenStreamDelete(f->stream);
+	if (f->lines != NULL)
+		LinesDelete(f->lines);
+
+	// Release file contents
+	if (f->mapped)
+		munmap(f->data, f->size);
+	else
+		free(f->data);
+
+	free(f);
+}
+
+static uint32_t FileHash(dev_t dev, ino_t ino)
+{
+	uint64_t h = ((uint64_t)dev * 0x9E3779B97F4A7C15ull) ^ (uint64_t)ino;
+
+	return (uint32_t)(h ^ (h >> 32));
+}
+
+static void FileLruRemove(cparserfile_t *f)
+{
+	if (f->lru_prev != NULL)
+		f->lru_prev->lru_next = f->lru_next;
+	else
+		file_cache.lru_head = f->lru_next;
+
+	if (f->lru_next != NULL)
+		f->lru_next->lru_prev = f->lru_prev;
+	else
+		file_cache.lru_tail = f->lru_prev;
+
+	f->lru_prev = NULL;
+	f->lru_next = NULL;
+}
+
+static void FileLruPush(cparserfile_t *f)
+{
+	f->lru_prev = NULL;
+	f->lru_next = file_cache.lru_head;
+	if (file_cache.lru_head != NULL)
+		file_cache.lru_head->lru_prev = f;
+	else
+		file_cache.lru_tail = f;
+	file_cache.lru_head = f;
+}
+
+static void FileCacheRemove(cparserfile_t *f)
+{
+	cparserfile_t **link = &file_cache.buckets[FileHash(f->dev, f->ino) & (file_cache.buckets_size - 1)];
+
+	// Unchain from its bucket, it is released by its last user
+	while (*link != f)
+		link = &(*link)->next;
+	*link = f->next;
+
+	f->cached = false;
+	file_cache.count--;
+	file_cache.size -= f->size;
+}
+
+static void FileCacheTrim(void)
+{
+	// Evict least recently released files while over budget, referenced files stay
+	while ((file_cache.size > file_cache.budget) && (file_cache.lru_tail != NULL))
+	{
+		cparserfile_t *f = file_cache.lru_tail;
+
+		FileLruRemove(f);
+		FileCacheRemove(f);
+		FileRelease(f);
+	}
+}
+
+static void FileCacheGrow(void)
+{
+	cparserfile_t **old = file_cache.buckets;
+	uint32_t old_size = file_cache.buckets_size;
+
+	// Keep at most one file per bucket on average, rehash files
+	file_cache.buckets_size = old_size ? old_size * 2 : FILE_CACHE_MIN_BUCKETS;
+	file_cache.buckets = calloc(file_cache.buckets_size, sizeof(cparserfile_t *));
+	for (uint32_t i = 0; i < old_size; i++)
+	{
+		cparserfile_t *f = old[i];
+
+		while (f != NULL)
+		{
+			cparserfile_t *next = f->next;
+			uint32_t j = FileHash(f->dev, f->ino) & (file_cache.buckets_size - 1);
+
+			f->next = file_cache.buckets[j];
+			file_cache.buckets[j] = f;
+			f = next;
+		}
+	}
+	free(old);
+}
+
+static cparserfile_t *FileCacheFind(const struct stat *st)
+{
+	cparserfile_t *f;
+
+	if (file_cache.buckets_size == 0)
+		return NULL;
+
+	f = file_cache.buckets[FileHash(st->st_dev, st->st_ino) & (file_cache.buckets_size - 1)];
+	while (f != NULL)
+	{
+		cparserfile_t *next = f->next;
+
+		if ((f->dev == st->st_dev) && (f->ino == st->st_ino))
+		{
+			if ((f->mtime.tv_sec == st->st_mtim.tv_sec) && (f->mtime.tv_nsec == st->st_mtim.tv_nsec) && (f->st_size == st->st_size))
+				return f;
+
+			// File changed since it was cached, drop the old contents
+			FileCacheRemove(f);
+			if (f->refs == 0)
+			{
+				FileLruRemove(f);
+				FileRelease(f);
+			}
+		}
+
+		f = next;
+	}
+
+	return NULL;
+}
+
+static void FileCacheAdd(cparserfile_t *f, const struct stat *st)
+{
+	uint32_t i;
+
+	if (file_cache.count >= file_cache.buckets_size)
+		FileCacheGrow();
+
+	f->dev = st->st_dev;
+	f->ino = st->st_ino;
+	f->mtime = st->st_mtim;
+	f->st_size = st->st_size;
+	f->cached = true;
+
+	i = FileHash(f->dev, f->ino) & (file_cache.buckets_size - 1);
+	f->next = file_cache.buckets[i];
+	file_cache.buckets[i] = f;
+	file_cache.count++;
+	file_cache.size += f->size;
+}
+
+/**
+ * Gets the contents of an opened file
+ *
+ * Regular files are cached by device, inode, modification time and size, so
+ * a file is read once while it is unchanged and it fits the cache budget. The
+ * stream can be closed right after.
+ *
+ * \param[in]	f:	opened file
+ *
+ * \return file contents, release them with FileDelete. NULL if the file cannot be read
+ */
+cparserfile_t *FileNew(FILE *f)
+{
+	cparserfile_t *res;
+	struct stat st;
+	int fd;
+
+	if (f == NULL)
+		return NULL;
+
+	fd = fileno(f);
+	if (fstat(fd, &st) != 0)
+		st.st_mode = 0;
+
+	// Take cached contents, they leave the LRU list while referenced
+	if (S_ISREG(st.st_mode) && ((res = FileCacheFind(&st)) != NULL))
+	{
+		if (res->refs++ == 0)
+			FileLruRemove(res);
+		return res;
+	}
+
+	res = malloc(sizeof(cparserfile_t));
+	res->cached = false;
+	res->refs = 1;
+	res->stream = NULL;
+	res->lines = NULL;
+	res->next = NULL;
+	res->lru_prev = NULL;
+	res->lru_next = NULL;
+
+	// Map the file, or read it if it cannot be mapped
+	if (!FileMap(res, fd, &st) && !FileRead(res, fd))
+	{
+		free(res);
+		return NULL;
+	}
+
+	// Only regular files are cached, the rest are read every time
+	if (S_ISREG(st.st_mode))
+		FileCacheAdd(res, &st);
+
+	return res;
+}
+
+void FileDelete(cparserfile_t *f)
+{
+	if (f == NULL)
+		return;
+
+	// Cached contents are kept until evicted
+	if (--f->refs > 0)
+		return;
+
+	if (!f->cached)
+	{
+		FileRelease(f);
+		return;
+	}
+
+	FileLruPush(f);
+	FileCacheTrim();
+}
+
+/**
+ * Sets the size of file contents kept cached
+ *
+ * Files not used by any parser are evicted, least recently used first, while
+ * cached contents exceed the budget. Files in use are never evicted.
+ *
+ * \param[in]	budget:		cached contents size in bytes
+ */
+void FileSetCacheBudget(size_t budget)
+{
+	file_cache.budget = budget;
+	FileCacheTrim();
+}
+
+const uint8_t *FileGetData(const cparserfile_t *f)
+{
+	return (f != NULL) ? f->data : NULL;
+}
+
+size_t FileGetSize(const cparserfile_t *f)
+{
+	return (f != NULL) ? f->size : 0;
+}
+
+/**
+ * Gets the tokens of a file, lexing them the first time
+ *
+ * Tokens stay with the cached contents, so every parse of an unchanged file
+ * after the first one reuses them.
+ *
+ * \param[in]	f:	file contents
+ *
+ * \return token stream of the contents, NULL if there are no contents
+ */
+const cparsertokenstream_t *FileGetStream(cparserfile_t *f)
+{
+	if (f == NULL)
+		return NULL;
+
+	if (f->stream == NULL)
+		f->stream = TokenStreamNew(f->data, f->size);
+
+	return f->stream;
+}
+
+/**
+ * Gets the line index of a file, it stays with the cached contents like its tokens
+ *
+ * \param[in]	f:	file contents
+ *
+ * \return line index of the contents, NULL if there are no contents
+ */
+const cparserlines_t *FileGetLines(cparserfile_t *f)
+{
+	if (f == NULL)
+		return NULL;
+
+	if (f->lines == NULL)
+		f->lines = LinesNew(f->data, f->size);
+
+	return f->lines;
+}
+
+/**
+ * Gets the include guard macro of a file without reading it
+ *
+ * \param[in]	st:		file status
+ *
+ * \return guard macro of the cached file, ATOM_NONE if not lexed yet or not guarded
+ */
+atom_t FileGetGuard(const struct stat *st)
+{
+	cparserfile_t *f;
+
+	if (!S_ISREG(st->st_mode) || ((f = FileCacheFind(st)) == NULL) || (f->stream == NULL))
+		return ATOM_NONE;
+
+	// Guard is detected when the contents are lexed
+	return TokenStreamGetGuard(f->stream);
+}
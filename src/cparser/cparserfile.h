@@ -0,0 +1,29 @@
+/*
+ * cparserfile.h
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#ifndef CPARSER_CPARSERFILE_H_
+#define CPARSER_CPARSERFILE_H_
+
+
+struct cparserfile_s;
+typedef struct cparserfile_s cparserfile_t;
+struct stat;
+struct cparserlines_s;
+struct cparsertokenstream_s;
+
+
+cparserfile_t *FileNew(FILE *f);
+void FileDelete(cparserfile_t *f);
+void FileSetCacheBudget(size_t budget);
+const uint8_t *FileGetData(const cparserfile_t *f);
+size_t FileGetSize(const cparserfile_t *f);
+const struct cparsertokenstream_s *FileGetStream(cparserfile_t *f);
+const struct cparserlines_s *FileGetLines(cparserfile_t *f);
+atom_t FileGetGuard(const struct stat *st);
+
+
+#endif /* CPARSER_CPARSERFILE_H_ */
@@ -0,0 +1,167 @@
+/*
+ * cparserkeyword.c
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "cparsertools.h"
+#include "cparserkeyword.h"
+
+
+#define KEYWORD_HASH_BITS			7
+#define KEYWORD_HASH_SIZE			(1 << KEYWORD_HASH_BITS)
+#define KEYWORD_HASH_MULTIPLIER		0x3c4beb2bu		// Found by search, no two keywords share a slot
+
+
+// Keyword hash table slot
+typedef struct keyword_slot_s
+{
+	const uint8_t *name;		// Keyword, NULL if slot is empty
+	uint8_t length;				// Keyword length
+	keyword_t keyword;			// Keyword identifier
+} keyword_slot_t;
+
+
+// Perfect hash table, slot of each keyword is KeywordHash of its name
+static const keyword_slot_t keyword_table[KEYWORD_HASH_SIZE] =
+{
+	[1]   = { _T "if",		2, CPARSER_KEYWORD_IF },
+	[2]   = { _T "break",	5, CPARSER_KEYWORD_BREAK },
+	[3]   = { _T "line",	4, CPARSER_KEYWORD_LINE },
+	[7]   = { _T "struct",	6, CPARSER_KEYWORD_STRUCT },
+	[8]   = { _T "union",	5, CPARSER_KEYWORD_UNION },
+	[10]  = { _T "typedef",	7, CPARSER_KEYWORD_TYPEDEF },
+	[12]  = { _T "signed",	6, CPARSER_KEYWORD_SIGNED },
+	[18]  = { _T "inline",	6, CPARSER_KEYWORD_INLINE },
+	[20]  = { _T "error",	5, CPARSER_KEYWORD_ERROR },
+	[21]  = { _T "for",		3, CPARSER_KEYWORD_FOR },
+	[23]  = { _T "auto",	4, CPARSER_KEYWORD_AUTO },
+	[24]  = { _T "elif",	4, CPARSER_KEYWORD_ELIF },
+	[27]  = { _T "enum",	4, CPARSER_KEYWORD_ENUM },
+	[30]  = { _T "default",	7, CPARSER_KEYWORD_DEFAULT },
+	[31]  = { _T "void",	4, CPARSER_KEYWORD_VOID },
+	[33]  = { _T "double",	6, CPARSER_KEYWORD_DOUBLE },
+	[34]  = { _T "else",	4, CPARSER_KEYWORD_ELSE },
+	[37]  = { _T "define",	6, CPARSER_KEYWORD_DEFINE },
+	[38]  = { _T "pragma",	6, CPARSER_KEYWORD_PRAGMA },
+	[39]  = { _T "include",	7, CPARSER_KEYWORD_INCLUDE },
+	[42]  = { _T "short",	5, CPARSER_KEYWORD_SHORT },
+	[46]  = { _T "continue",8, CPARSER_KEYWORD_CONTINUE },
+	[49]  = { _T "unsigned",8, CPARSER_KEYWORD_UNSIGNED },
+	[53]  = { _T "int",		3, CPARSER_KEYWORD_INT },
+	[55]  = { _T "extern",	6, CPARSER_KEYWORD_EXTERN },
+	[56]  = { _T "static",	6, CPARSER_KEYWORD_STATIC },
+	[57]  = { _T "float",	5, CPARSER_KEYWORD_FLOAT },
+	[62]  = { _T "while",	5, CPARSER_KEYWORD_WHILE },
+	[66]  = { _T "ifdef",	5, CPARSER_KEYWORD_IFDEF },
+	[68]  = { _T "case",	4, CPARSER_KEYWORD_CASE },
+	[69]  = { _T "defined",	7, CPARSER_KEYWORD_DEFINED },
+	[71]  = { _T "char",	4, CPARSER_KEYWORD_CHAR },
+	[75]  = { _T "warning",	7, CPARSER_KEYWORD_WARNING },
+	[81]  = { _T "const",	5, CPARSER_KEYWORD_CONST },
+	[82]  = { _T "long",	4, CPARSER_KEYWORD_LONG },
+	[87]  = { _T "ifndef",	6, CPARSER_KEYWORD_IFNDEF },
+	[90]  = { _T "restrict",8, CPARSER_KEYWORD_RESTRICT },
+	[91]  = { _T "undef",	5, CPARSER_KEYWORD_UNDEF },
+	[99]  = { _T "do",		2, CPARSER_KEYWORD_DO },
+	[104] = { _T "goto",	4, CPARSER_KEYWORD_GOTO },
+	[106] = { _T "volatile",8, CPARSER_KEYWORD_VOLATILE },
+	[110] = { _T "return",	6, CPARSER_KEYWORD_RETURN },
+	[111] = { _T "register",8, CPARSER_KEYWORD_REGISTER },
+	[117] = { _T "switch",	6, CPARSER_KEYWORD_SWITCH },
+	[119] = { _T "sizeof",	6, CPARSER_KEYWORD_SIZEOF },
+	[121] = { _T "endif",	5, CPARSER_KEYWORD_ENDIF },
+};
+
+// Classes of each keyword
+static const uint8_t keyword_class[CPARSER_KEYWORD_COUNT] =
+{
+	[CPARSER_KEYWORD_AUTO]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_SPECIFIER,
+	[CPARSER_KEYWORD_BREAK]		= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_CASE]		= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_CHAR]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_PRIMITIVE,
+	[CPARSER_KEYWORD_CONST]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_QUALIFIER,
+	[CPARSER_KEYWORD_CONTINUE]	= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_DEFAULT]	= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_DO]		= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_DOUBLE]	= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_PRIMITIVE,
+	[CPARSER_KEYWORD_ELSE]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_ENUM]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_COMPOSED,
+	[CPARSER_KEYWORD_EXTERN]	= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_SPECIFIER,
+	[CPARSER_KEYWORD_FLOAT]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_PRIMITIVE,
+	[CPARSER_KEYWORD_FOR]		= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_GOTO]		= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_IF]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_INLINE]	= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_INT]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_PRIMITIVE,
+	[CPARSER_KEYWORD_LONG]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_MODIFIER,
+	[CPARSER_KEYWORD_REGISTER]	= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_SPECIFIER,
+	[CPARSER_KEYWORD_RESTRICT]	= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_RETURN]	= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_SHORT]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_MODIFIER,
+	[CPARSER_KEYWORD_SIGNED]	= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_MODIFIER,
+	[CPARSER_KEYWORD_SIZEOF]	= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_STATIC]	= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_SPECIFIER,
+	[CPARSER_KEYWORD_STRUCT]	= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_COMPOSED,
+	[CPARSER_KEYWORD_SWITCH]	= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_TYPEDEF]	= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_SPECIFIER,
+	[CPARSER_KEYWORD_UNION]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_COMPOSED,
+	[CPARSER_KEYWORD_UNSIGNED]	= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_MODIFIER,
+	[CPARSER_KEYWORD_VOID]		= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_PRIMITIVE,
+	[CPARSER_KEYWORD_VOLATILE]	= CPARSER_KEYWORD_CLASS_C | CPARSER_KEYWORD_CLASS_QUALIFIER,
+	[CPARSER_KEYWORD_WHILE]		= CPARSER_KEYWORD_CLASS_C,
+	[CPARSER_KEYWORD_DEFINE]	= CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_DEFINED]	= CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_ELIF]		= CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_ENDIF]		= CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_ERROR]		= CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_IFDEF]		= CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_IFNDEF]	= CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_INCLUDE]	= CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_LINE]		= CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_PRAGMA]	= CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_UNDEF]		= CPARSER_KEYWORD_CLASS_PREPROCESSOR,
+	[CPARSER_KEYWORD_WARNING]	= 0,		// Directive name only, it can be defined
+};
+
+
+static inline uint32_t KeywordHash(const uint8_t *s, uint32_t length)
+{
+	// Mix first, second and last chars with length, keep the top bits of the product
+	uint32_t key = s[0] | (s[1] << 8) | (s[length - 1] << 16) | (length << 24);
+
+	return (key * KEYWORD_HASH_MULTIPLIER) >> (32 - KEYWORD_HASH_BITS);
+}
+
+/**
+ * Finds the keyword spelled by an identifier, with one hash and one compare
+ *
+ * \param[in]	s:		identifier bytes, not null terminated
+ * \param[in]	length:	identifier bytes count
+ *
+ * \return keyword, CPARSER_KEYWORD_NONE if the identifier is not a keyword
+ */
+keyword_t KeywordFind(const uint8_t *s, uint32_t length)
+{
+	const keyword_slot_t *slot;
+
+	// Too short or too long to be a keyword
+	if (length < 2 || length > CPARSER_KEYWORD_LENGTH_MAX)
+		return CPARSER_KEYWORD_NONE;
+
+	slot = &keyword_table[KeywordHash(s, length)];
+	if (slot->length == length && memcmp(slot->name, s, length) == 0)
+		return slot->keyword;
+
+	return CPARSER_KEYWORD_NONE;
+}
+
+uint32_t KeywordGetClass(keyword_t keyword)
+{
+	return keyword_class[keyword];
+}
@@ -0,0 +1,82 @@
+/*
+ * cparserkeyword.h
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#ifndef CPARSER_CPARSERKEYWORD_H_
+#define CPARSER_CPARSERKEYWORD_H_
+
+
+// Keyword classes
+#define CPARSER_KEYWORD_CLASS_C					1		// C keyword
+#define CPARSER_KEYWORD_CLASS_PREPROCESSOR		2		// Preprocessor keyword, it cannot be defined nor undefined
+#define CPARSER_KEYWORD_CLASS_SPECIFIER			4		// Storage class specifier or typedef
+#define CPARSER_KEYWORD_CLASS_QUALIFIER			8		// Type qualifier
+#define CPARSER_KEYWORD_CLASS_MODIFIER			16		// Basic datatype modifier
+#define CPARSER_KEYWORD_CLASS_PRIMITIVE			32		// Basic built in datatype
+#define CPARSER_KEYWORD_CLASS_COMPOSED			64		// Composed datatype
+
+#define CPARSER_KEYWORD_LENGTH_MAX				8
+
+
+// Keyword, C keywords first then the preprocessor only ones
+typedef enum keyword_e
+{
+	CPARSER_KEYWORD_NONE = 0,
+	CPARSER_KEYWORD_AUTO,
+	CPARSER_KEYWORD_BREAK,
+	CPARSER_KEYWORD_CASE,
+	CPARSER_KEYWORD_CHAR,
+	CPARSER_KEYWORD_CONST,
+	CPARSER_KEYWORD_CONTINUE,
+	CPARSER_KEYWORD_DEFAULT,
+	CPARSER_KEYWORD_DO,
+	CPARSER_KEYWORD_DOUBLE,
+	CPARSER_KEYWORD_ELSE,
+	CPARSER_KEYWORD_ENUM,
+	CPARSER_KEYWORD_EXTERN,
+	CPARSER_KEYWORD_FLOAT,
+	CPARSER_KEYWORD_FOR,
+	CPARSER_KEYWORD_GOTO,
+	CPARSER_KEYWORD_IF,
+	CPARSER_KEYWORD_INLINE,
+	CPARSER_KEYWORD_INT,
+	CPARSER_KEYWORD_LONG,
+	CPARSER_KEYWORD_REGISTER,
+	CPARSER_KEYWORD_RESTRICT,
+	CPARSER_KEYWORD_RETURN,
+	CPARSER_KEYWORD_SHORT,
+	CPARSER_KEYWORD_SIGNED,
+	CPARSER_KEYWORD_SIZEOF,
+	CPARSER_KEYWORD_STATIC,
+	CPARSER_KEYWORD_STRUCT,
+	CPARSER_KEYWORD_SWITCH,
+	CPARSER_KEYWORD_TYPEDEF,
+	CPARSER_KEYWORD_UNION,
+	CPARSER_KEYWORD_UNSIGNED,
+	CPARSER_KEYWORD_VOID,
+	CPARSER_KEYWORD_VOLATILE,
+	CPARSER_KEYWORD_WHILE,
+	CPARSER_KEYWORD_DEFINE,
+	CPARSER_KEYWORD_DEFINED,
+	CPARSER_KEYWORD_ELIF,
+	CPARSER_KEYWORD_ENDIF,
+	CPARSER_KEYWORD_ERROR,
+	CPARSER_KEYWORD_IFDEF,
+	CPARSER_KEYWORD_IFNDEF,
+	CPARSER_KEYWORD_INCLUDE,
+	CPARSER_KEYWORD_LINE,
+	CPARSER_KEYWORD_PRAGMA,
+	CPARSER_KEYWORD_UNDEF,
+	CPARSER_KEYWORD_WARNING,
+	CPARSER_KEYWORD_COUNT
+} keyword_t;
+
+
+keyword_t KeywordFind(const uint8_t *s, uint32_t length);
+uint32_t KeywordGetClass(keyword_t keyword);
+
+
+#endif /* CPARSER_CPARSERKEYWORD_H_ */
@@ -0,0 +1,110 @@
+/*
+ * cparserlines.c
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "cparserscan.h"
+#include "cparserlines.h"
+
+
+struct cparserlines_s
+{
+	const uint8_t *data;	// File contents, they shall live as long as the index
+	size_t size;			// File contents size
+	uint32_t *newlines;		// Offset of each new line in the file, sorted, NULL until a position is requested
+	uint32_t count;			// Number of new lines
+};
+
+
+static void LinesIndex(cparserlines_t *lines)
+{
+	const uint8_t *end = lines->data + lines->size;
+	const uint8_t *p = lines->data;
+
+	// Count new lines first so the index is allocated once with its exact size
+	lines->count = ScanCountNewlines(lines->data, end);
+	lines->newlines = malloc(sizeof(uint32_t) * (lines->count + 1));
+
+	// Record the offset of every new line
+	for (uint32_t i = 0; i < lines->count; i++)
+	{
+		p = ScanNewline(p, end);
+		lines->newlines[i] = p - lines->data;
+		p++;
+	}
+}
+
+/**
+ * Creates the line index of a file
+ *
+ * New lines are not searched until the first position is requested, files
+ * whose positions are never printed are not scanned at all.
+ *
+ * \param[in]	data:	File contents, they shall live as long as the index
+ * \param[in]	size:	File contents size
+ *
+ * \return line index, release it with LinesDelete
+ */
+cparserlines_t *LinesNew(const uint8_t *data, size_t size)
+{
+	cparserlines_t *res = malloc(sizeof(cparserlines_t));
+
+	res->data = data;
+	res->size = size;
+	res->newlines = NULL;
+	res->count = 0;
+
+	return res;
+}
+
+void LinesDelete(cparserlines_t *lines)
+{
+	if (!lines)
+		return;
+
+	free(lines->newlines);
+	free(lines);
+}
+
+/**
+ * Computes row and column of a byte offset
+ *
+ * Rows and columns are the ones the tokenizer tracks while reading: the first row starts at column 1,
+ * a new line char is column 1 of the row it opens, and the chars after it follow from column 2.
+ *
+ * \param[in]	lines:	Line index of the file
+ * \param[in]	offset:	Byte offset in the file
+ * \param[out]	row:	Row of the byte
+ * \param[out]	column:	Column of the byte
+ */
+void LinesGetPosition(const cparserlines_t *lines, uint32_t offset, uint32_t *row, uint32_t *column)
+{
+	uint32_t lo = 0;
+	uint32_t hi;
+
+	// Index is built with the first position requested, it does not change what the index describes
+	if (lines->newlines == NULL)
+		LinesIndex((cparserlines_t *)lines);
+
+	hi = lines->count;
+
+	// Binary search the number of new lines at or before offset
+	while (lo < hi)
+	{
+		uint32_t mid = lo + (hi - lo) / 2;
+
+		if (lines->newlines[mid] <= offset)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	*row = lo + 1;
+	*column = (lo == 0) ? offset + 1 : offset - lines->newlines[lo - 1] + 1;
+}
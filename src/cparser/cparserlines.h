@@ -0,0 +1,21 @@
+/*
+ * cparserlines.h
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#ifndef CPARSER_CPARSERLINES_H_
+#define CPARSER_CPARSERLINES_H_
+
+
+struct cparserlines_s;
+typedef struct cparserlines_s cparserlines_t;
+
+
+cparserlines_t *LinesNew(const uint8_t *data, size_t size);
+void LinesDelete(cparserlines_t *lines);
+void LinesGetPosition(const cparserlines_t *lines, uint32_t offset, uint32_t *row, uint32_t *column);
+
+
+#endif /* CPARSER_CPARSERLINES_H_ */
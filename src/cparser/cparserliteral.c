@@ -0,0 +1,195 @@
+/*
+ * cparserliteral.c
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "cparserliteral.h"
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define LITERAL_SWAR
+#endif
+
+
+#define LITERAL_DIGIT_NONE			0			// Table entry of chars that are not digits
+#define LITERAL_SWAR_DIGITS			8			// Decimal digits decoded at once
+#define LITERAL_SWAR_SCALE			100000000u	// 10 ^ LITERAL_SWAR_DIGITS
+
+
+// Value plus one of each digit char in any base, LITERAL_DIGIT_NONE if not a digit
+static const uint8_t literal_digit[256] =
+{
+	['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5, ['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+	['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+	['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16
+};
+
+
+// Digit value of a char, non digits wrap around to UINT32_MAX so they are out of every base
+static inline uint32_t LiteralDigit(uint8_t c)
+{
+	return (uint32_t)literal_digit[c] - 1;
+}
+
+#ifdef LITERAL_SWAR
+static inline bool LiteralIsEightDigits(uint64_t v)
+{
+	// Every byte is in '0'..'9' when its high nibble is 3, also after adding 6
+	return (((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull);
+}
+
+static inline uint32_t LiteralEightDigits(uint64_t v)
+{
+	// Combine digits in pairs, then in fours, then in eights. First digit is the lowest byte
+	v = ((v & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+	v = ((v & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+	return (uint32_t)(((v & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32);
+}
+#endif
+
+static bool LiteralDecimalRun(const uint8_t **p, const uint8_t *end, uintmax_t *value)
+{
+	const uint8_t *s = *p;
+	uintmax_t v = *value;
+
+#ifdef LITERAL_SWAR
+	// Eight digits at once while they last
+	while (end - s >= LITERAL_SWAR_DIGITS)
+	{
+		uint64_t chunk;
+
+		memcpy(&chunk, s, sizeof(chunk));
+		if (!LiteralIsEightDigits(chunk))
+			break;
+
+		if (__builtin_mul_overflow(v, LITERAL_SWAR_SCALE, &v) || __builtin_add_overflow(v, LiteralEightDigits(chunk), &v))
+			return false;
+		s += LITERAL_SWAR_DIGITS;
+	}
+#endif
+
+	// Remaining digits one by one
+	while ((s < end) && (LiteralDigit(*s) < 10))
+	{
+		if (__builtin_mul_overflow(v, 10, &v) || __builtin_add_overflow(v, LiteralDigit(*s), &v))
+			return false;
+		s++;
+	}
+
+	*p = s;
+	*value = v;
+
+	return true;
+}
+
+static bool LiteralRadixRun(const uint8_t **p, const uint8_t *end, uint32_t shift, uintmax_t *value)
+{
+	const uint8_t *s = *p;
+	uintmax_t v = *value;
+	uint32_t base = 1u << shift;
+
+	// Power of two bases, a digit overflows when it would shift out set bits
+	while ((s < end) && (LiteralDigit(*s) < base))
+	{
+		if (v >> (sizeof(uintmax_t) * 8 - shift))
+			return false;
+		v = (v << shift) | LiteralDigit(*s);
+		s++;
+	}
+
+	*p = s;
+	*value = v;
+
+	return true;
+}
+
+static bool LiteralSuffix(const uint8_t *s, const uint8_t *end, bool *is_unsigned)
+{
+	bool u = false;
+	bool l = false;
+
+	// Any order of one U and one L or LL, LL shall have both letters in the same case
+	while (s < end)
+	{
+		if (((*s == 'u') || (*s == 'U')) && !u)
+		{
+			u = true;
+			s++;
+		}
+		else if (((*s == 'l') || (*s == 'L')) && !l)
+		{
+			l = true;
+			s += ((end - s > 1) && (s[1] == s[0])) ? 2 : 1;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	*is_unsigned = u;
+
+	return true;
+}
+
+/**
+ * Decodes an integer literal the way the preprocessor does
+ *
+ * Decimal, octal, hexadecimal and binary literals are accepted with any
+ * combination of U, L and LL suffixes. Values are taken as uintmax_t when
+ * suffixed with U or too large for intmax_t, and as intmax_t otherwise.
+ *
+ * \param[in]	s:		literal bytes, not null terminated
+ * \param[in]	length:	literal bytes count
+ * \param[out]	li:		decoded value and signedness
+ *
+ * \return false if it is not a valid integer literal or it does not fit in uintmax_t
+ */
+bool LiteralDecodeInteger(const uint8_t *s, uint32_t length, literal_integer_t *li)
+{
+	const uint8_t *end = s + length;
+	const uint8_t *digits;
+	bool ok;
+
+	li->value = 0;
+	li->is_unsigned = false;
+
+	if ((length == 0) || (LiteralDigit(*s) >= 10))
+		return false;
+
+	// Classify by prefix and decode the digit run
+	if ((s[0] == '0') && (length > 1) && ((s[1] == 'x') || (s[1] == 'X')))
+	{
+		digits = s + 2;
+		s = digits;
+		ok = LiteralRadixRun(&s, end, 4, &li->value) && (s != digits);
+	}
+	else if ((s[0] == '0') && (length > 1) && ((s[1] == 'b') || (s[1] == 'B')))
+	{
+		digits = s + 2;
+		s = digits;
+		ok = LiteralRadixRun(&s, end, 1, &li->value) && (s != digits);
+	}
+	else if (s[0] == '0')
+	{
+		ok = LiteralRadixRun(&s, end, 3, &li->value);
+	}
+	else
+	{
+		ok = LiteralDecimalRun(&s, end, &li->value);
+	}
+
+	// Only suffixes may follow digits, digits of other bases or a dot make it invalid
+	if (!ok || !LiteralSuffix(s, end, &li->is_unsigned))
+		return false;
+
+	if (li->value > INTMAX_MAX)
+		li->is_unsigned = true;
+
+	return true;
+}
@@ -0,0 +1,23 @@
+/*
+ * cparserliteral.h
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#ifndef CPARSER_CPARSERLITERAL_H_
+#define CPARSER_CPARSERLITERAL_H_
+
+
+// Integer literal decoded with preprocessor semantics, every value is intmax_t or uintmax_t
+typedef struct literal_integer_s
+{
+	uintmax_t value;
+	bool is_unsigned;			// U suffix, or value too large for intmax_t
+} literal_integer_t;
+
+
+bool LiteralDecodeInteger(const uint8_t *s, uint32_t length, literal_integer_t *li);
+
+
+#endif /* CPARSER_CPARSERLITERAL_H_ */
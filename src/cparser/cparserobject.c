@@ -12,10 +12,22 @@
 #include <stdio.h>
 #include <cparsertools.h>
 #include <cparsertoken.h>
+#include <cparserlines.h>
+#include <cparseratom.h>
+#include <cparserfile.h>
 #include <cparserobject.h>
 
 
 #define STR(A)	(#A)
+#define INCLUDE_SKIPPED_INFO	"Skipped by include guard "
+
+
+// File root object, positions of the objects below it are computed from the line index of its file
+typedef struct file_object_s
+{
+	object_t object;
+	cparserfile_t *file;		// File contents, their line index is built when a position is printed
+} file_object_t;
 
 
 static const char *object_type_names[OBJECT_TYPE_COUNT] =
@@ -38,6 +50,7 @@ static const char *object_type_names[OBJECT_TYPE_COUNT] =
 		STR(OBJECT_TYPE_INCLUDE),
 		STR(OBJECT_TYPE_INCLUDE_FILENAME),
 		STR(OBJECT_TYPE_INCLUDE_OBJECT),
+		STR(OBJECT_TYPE_INCLUDE_SKIPPED),
 		STR(OBJECT_TYPE_SOURCE_FILE),
 		STR(OBJECT_TYPE_HEADER_FILE),
 		STR(OBJECT_TYPE_WARNING),
@@ -97,9 +110,141 @@ object_t *ObjectNewPreprocessorExpression(const uint8_t *expression)
 	oo->children_size = 0;
 	oo->children_count = 0;
 	oo->info = NULL;
-	oo->row = 0;
-	oo->column = 0;
+	oo->offset = OBJECT_OFFSET_NONE;
 	oo->data = _T strdup(_t expression);
+	oo->atom = ATOM_NONE;
+	oo->value = 0;
+	oo->value_unsigned = false;
+	oo->value_generation = OBJECT_VALUE_NONE;
+	oo->value_stamp = 0;
+	oo->value_bindings = NULL;
+	oo->value_bindings_count = 0;
+	oo->in_block = false;
+
+	// Return children
+	return oo;
+}
+
+/**
+ * Creates many preprocessor expression objects in one block
+ *
+ * Objects do not own their expressions and are only released at once with ObjectDeletePreprocessorExpressions.
+ *
+ * \param[in]	expressions:	Expressions of the objects, they are not copied so they shall live as long as the objects
+ * \param[in]	count:			Expressions count
+ *
+ * \return array of count objects
+ */
+object_t *ObjectNewPreprocessorExpressions(uint8_t **expressions, uint32_t count)
+{
+	object_t *oo = malloc(sizeof(object_t) * (count ? count : 1));
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		oo[i].type = OBJECT_TYPE_PREPROCESSOR_EXPRESSION;
+		oo[i].parent = NULL;
+		oo[i].children = NULL;
+		oo[i].children_size = 0;
+		oo[i].children_count = 0;
+		oo[i].info = NULL;
+		oo[i].offset = OBJECT_OFFSET_NONE;
+		oo[i].data = expressions[i];
+		oo[i].atom = ATOM_NONE;
+		oo[i].value = 0;
+		oo[i].value_unsigned = false;
+		oo[i].value_generation = OBJECT_VALUE_NONE;
+		oo[i].value_stamp = 0;
+		oo[i].value_bindings = NULL;
+		oo[i].value_bindings_count = 0;
+		oo[i].in_block = true;
+	}
+
+	return oo;
+}
+
+/**
+ * Deletes a block of preprocessor expression objects created with ObjectNewPreprocessorExpressions
+ *
+ * \param[in]	oo:		Objects block
+ * \param[in]	count:	Objects count
+ */
+void ObjectDeletePreprocessorExpressions(object_t *oo, uint32_t count)
+{
+	if (oo == NULL)
+		return;
+
+	// Expressions belong to the caller, only cached values are released
+	for (uint32_t i = 0; i < count; i++)
+		free(oo[i].value_bindings);
+	free(oo);
+}
+
+/**
+ * Creates a file root object
+ *
+ * \param[in]	type:	Object type
+ * \param[in]	file:	File contents, the object takes the reference and releases it when deleted
+ *
+ * \return new root object
+ */
+object_t *ObjectNewFile(object_type_t type, cparserfile_t *file)
+{
+	file_object_t *ff = malloc(sizeof(file_object_t));
+	object_t *oo = &ff->object;
+
+	// Initialize new root object
+	oo->type = type;
+	oo->parent = NULL;
+	oo->children = NULL;
+	oo->children_size = 0;
+	oo->children_count = 0;
+	oo->info = NULL;
+	oo->offset = OBJECT_OFFSET_NONE;
+	oo->data = NULL;
+	oo->atom = ATOM_NONE;
+	oo->value = 0;
+	oo->value_unsigned = false;
+	oo->value_generation = OBJECT_VALUE_NONE;
+	oo->value_stamp = 0;
+	oo->value_bindings = NULL;
+	oo->value_bindings_count = 0;
+	oo->in_block = false;
+	ff->file = file;
+
+	// Return root
+	return oo;
+}
+
+/**
+ * Creates the object of an include skipped by its include guard
+ *
+ * \param[in]	filename:	Included filename, it is copied
+ * \param[in]	guard:		Guard macro still defined
+ *
+ * \return new object
+ */
+object_t *ObjectNewIncludeSkipped(const uint8_t *filename, atom_t guard)
+{
+	object_t *oo = malloc(sizeof(object_t));
+
+	// Initialize new object
+	oo->type = OBJECT_TYPE_INCLUDE_SKIPPED;
+	oo->parent = NULL;
+	oo->children = NULL;
+	oo->children_size = 0;
+	oo->children_count = 0;
+	oo->info = malloc(sizeof(INCLUDE_SKIPPED_INFO) + AtomGetLength(guard));
+	oo->offset = OBJECT_OFFSET_NONE;
+	oo->data = _T strdup(_t filename);
+	oo->atom = ATOM_NONE;
+	oo->value = 0;
+	oo->value_unsigned = false;
+	oo->value_generation = OBJECT_VALUE_NONE;
+	oo->value_stamp = 0;
+	oo->value_bindings = NULL;
+	oo->value_bindings_count = 0;
+	oo->in_block = false;
+	sprintf(_t oo->info, INCLUDE_SKIPPED_INFO "%.*s", AtomGetLength(guard), AtomGetString(guard));
 
 	// Return children
 	return oo;
@@ -116,18 +261,29 @@ object_t *ObjectAddChildFromToken(object_t *parent, object_type_t type, token_t
 	child->children_size = 0;
 	child->children_count = 0;
 	child->info = NULL;
-
-	// Add token data if any
-	if (token)
+	child->value = 0;
+	child->value_unsigned = false;
+	child->value_generation = OBJECT_VALUE_NONE;
+	child->value_stamp = 0;
+	child->value_bindings = NULL;
+	child->value_bindings_count = 0;
+	child->in_block = false;
+
+	// Add token data if any, identifiers share their interned string
+	child->atom = token ? token->atom : ATOM_NONE;
+	if (child->atom != ATOM_NONE)
+	{
+		child->offset = token->offset;
+		child->data = _T AtomGetString(child->atom);
+	}
+	else if (token)
 	{
-		child->row = token->row;
-		child->column = token->column;
-		child->data = _T strdup(_t token->str);
+		child->offset = token->offset;
+		child->data = _T strndup(_t token->slice, token->length);
 	}
 	else
 	{
-		child->row = 0;
-		child->column = 0;
+		child->offset = OBJECT_OFFSET_NONE;
 		child->data = NULL;
 	}
 
@@ -160,12 +316,84 @@ object_t *ObjectGetParent(object_t *o)
 	return (o != NULL) ? o->parent : NULL;
 }
 
-void ObjectPrint(FILE *f, const object_t *o, uint32_t level)
+static bool ObjectIsFile(const object_t *o)
+{
+	return (o->type == OBJECT_TYPE_SOURCE_FILE) || (o->type == OBJECT_TYPE_HEADER_FILE);
+}
+
+/**
+ * Deletes an object and all its children
+ *
+ * Identifier data are interned and are not released. Definitions added to
+ * dictionaries point to objects of the tree, so delete the tree after them.
+ *
+ * \param[in]	o:	Object to delete, NULL is allowed
+ */
+void ObjectDelete(object_t *o)
+{
+	// Objects of a block are only released with the whole block
+	if ((o == NULL) || o->in_block)
+		return;
+
+	for (uint32_t i = 0; i < o->children_count; i++)
+		ObjectDelete(o->children[i]);
+	free(o->children);
+
+	if (o->atom == ATOM_NONE)
+		free(o->data);
+	free(o->info);
+	free(o->value_bindings);
+
+	// Files release their contents
+	if (ObjectIsFile(o))
+		FileDelete(((file_object_t *)o)->file);
+
+	free(o);
+}
+
+static const cparserlines_t *ObjectGetLines(const object_t *o)
 {
+	// Look for the file the object belongs to
+	while (o != NULL && !ObjectIsFile(o))
+		o = o->parent;
+
+	return (o != NULL) ? FileGetLines(((const file_object_t *)o)->file) : NULL;
+}
+
+static void ObjectComputePosition(const object_t *o, const cparserlines_t *lines, uint32_t *row, uint32_t *column)
+{
+	if (o->offset == OBJECT_OFFSET_NONE || lines == NULL)
+	{
+		// No position
+		*row = 0;
+		*column = 0;
+	}
+	else
+	{
+		// Compute position from file line index
+		LinesGetPosition(lines, o->offset, row, column);
+	}
+}
+
+void ObjectGetPosition(const object_t *o, uint32_t *row, uint32_t *column)
+{
+	ObjectComputePosition(o, ObjectGetLines(o), row, column);
+}
+
+static void ObjectPrintWithLines(FILE *f, const object_t *o, uint32_t level, const cparserlines_t *lines)
+{
+	uint32_t row;
+	uint32_t column;
+
 	if (!o)
 		return;
 
-	fprintf(f, "%*c<object type=\"%s\" row=\"%d\" column=\"%d\">\n", 4 * level, ' ', object_type_names[o->type], o->row, o->column);
+	// Objects below a file take positions from its line index
+	if (ObjectIsFile(o))
+		lines = FileGetLines(((const file_object_t *)o)->file);
+
+	ObjectComputePosition(o, lines, &row, &column);
+	fprintf(f, "%*c<object type=\"%s\" row=\"%d\" column=\"%d\">\n", 4 * level, ' ', object_type_names[o->type], row, column);
 
 	if (o->data && strlen(_t o->data))
 	{
@@ -186,7 +414,7 @@ void ObjectPrint(FILE *f, const object_t *o, uint32_t level)
 		fprintf(f, "%*c<children>\n", 4 * (level + 1), ' ');
 		for (uint32_t i = 0; i < o->children_count; i++)
 		{
-			ObjectPrint(f, o->children[i], level + 2);
+			ObjectPrintWithLines(f, o->children[i], level + 2, lines);
 		}
 		fprintf(f, "%*c</children>\n", 4 * (level + 1), ' ');
 	}
@@ -194,6 +422,14 @@ void ObjectPrint(FILE *f, const object_t *o, uint32_t level)
 	fprintf(f, "%*c</object>\n", 4 * level, ' ');
 }
 
+void ObjectPrint(FILE *f, const object_t *o, uint32_t level)
+{
+	if (!o)
+		return;
+
+	ObjectPrintWithLines(f, o, level, ObjectGetLines(o));
+}
+
 void ObjectPrintRoot(const uint8_t *filename, const object_t *o)
 {
 	FILE *f;
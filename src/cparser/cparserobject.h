@@ -9,6 +9,13 @@
 #define CPARSER_CPARSEROBJECT_H_
 
 
+#define OBJECT_OFFSET_NONE		UINT32_MAX
+
+#define OBJECT_VALUE_NONE		0				// Value not evaluated
+#define OBJECT_VALUE_CONSTANT	UINT64_MAX		// Value does not depend on other definitions
+#define OBJECT_VALUE_EVALUATING	(UINT64_MAX - 1)	// Value is being evaluated or checked, references to it are not expanded
+
+
 // Parse object type
 typedef enum object_type_e
 {
@@ -30,6 +37,7 @@ typedef enum object_type_e
 	OBJECT_TYPE_INCLUDE,
 	OBJECT_TYPE_INCLUDE_FILENAME,
 	OBJECT_TYPE_INCLUDE_OBJECT,
+	OBJECT_TYPE_INCLUDE_SKIPPED,			// Header not opened because its include guard is defined
 	OBJECT_TYPE_SOURCE_FILE,
 	OBJECT_TYPE_HEADER_FILE,
 	OBJECT_TYPE_WARNING,
@@ -71,27 +79,50 @@ typedef enum object_type_e
 	OBJECT_TYPE_COUNT
 } object_type_t;
 
+// Definition a cached value was evaluated with
+typedef struct object_binding_s
+{
+	uint32_t atom;						// Identifier the value depends on
+	const void *definition;				// Its definition in the dictionary, NULL if it was not defined
+	uint32_t value_stamp;				// Stamp of the definition value, 0 if it was not evaluated
+} object_binding_t;
+
 // Parse object
+// Cached values are shared by every dictionary snapshot holding the definition, so they are evaluated
+// and checked from a single thread
 typedef struct object_s
 {
 	object_type_t type;
+	uint32_t offset;			// Byte offset in its file, OBJECT_OFFSET_NONE if none
 	struct object_s *parent;
 	struct object_s **children;
 	uint32_t children_size;
 	uint32_t children_count;
 
-	uint32_t row;
-	uint32_t column;
 	uint8_t * data;
 	uint8_t * info;
+	uint32_t atom;				// Atom of data when it is an interned identifier, ATOM_NONE otherwise
+	intmax_t value;				// Cached value of data when it is a preprocessor expression
+	bool value_unsigned;		// Cached value is uintmax_t
+	uint64_t value_generation;	// Definitions generation value was checked with, or OBJECT_VALUE_XXX
+	uint32_t value_stamp;		// Changes each time the cached value changes, 0 if never evaluated
+	object_binding_t *value_bindings;	// Definitions the cached value depends on
+	uint32_t value_bindings_count;
+	bool in_block;				// Object and its data belong to a block of objects, only released with the whole block
 } object_t;
 
 object_t *ObjectNewPreprocessorExpression(const uint8_t *expression);
+object_t *ObjectNewPreprocessorExpressions(uint8_t **expressions, uint32_t count);
+void ObjectDeletePreprocessorExpressions(object_t *oo, uint32_t count);
+object_t *ObjectNewFile(object_type_t type, cparserfile_t *file);
+object_t *ObjectNewIncludeSkipped(const uint8_t *filename, atom_t guard);
+void ObjectDelete(object_t *o);
 void ObjectAddChild(object_t *parent, object_t *child);
 object_t *ObjectAddChildFromToken(object_t *parent, object_type_t type, token_t *token);
 object_t *ObjectGetChildByType(object_t *parent, object_type_t type);
 object_t *ObjectGetLastChild(object_t *parent, object_type_t type);
 object_t *ObjectGetParent(object_t *o);
+void ObjectGetPosition(const object_t *o, uint32_t *row, uint32_t *column);
 void ObjectPrint(FILE *f, const object_t *o, uint32_t level);
 void ObjectPrintRoot(const uint8_t *filename, const object_t *o);
 
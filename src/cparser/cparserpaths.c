@@ -10,26 +10,359 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "cparsertools.h"
+#include "cparseratom.h"
+#include "cparserdictionary.h"
 #include "cparserpaths.h"
 
 
+#ifndef O_PATH
+#define O_PATH						O_RDONLY
+#endif
+
+#define PATHS_INDEX_NONE			UINT32_MAX
+#define PATHS_FD_NONE				-1
+
+// Kinds of directory entries in the index
+#define PATHS_ENTRY_NONE			0
+#define PATHS_ENTRY_FILE			1
+#define PATHS_ENTRY_DIRECTORY		2
+
+
+// Entries of an indexed directory, scanned the first time a lookup goes through it
+typedef struct paths_directory_s
+{
+	const uint8_t *path;					// Directory path, an atom string
+	struct timespec mtime;					// Modification time when scanned, zero if it could not be read
+	uint64_t checked;						// Refresh generation its modification time was last checked in
+	cparserdictionary_t *entries;			// PATHS_ENTRY_XXX by name atom, NULL until scanned
+} paths_directory_t;
+
+// Resolution of an include spelling with the search paths of a generation
+typedef struct paths_resolution_s
+{
+	uint64_t generation;		// Search paths generation it was resolved with
+	uint64_t index_generation;	// Directory index generation it was resolved with
+	uint32_t index;				// Search path the file was found at, PATHS_INDEX_NONE if in none
+} paths_resolution_t;
+
 typedef struct cparserpaths_s
 {
 	const uint8_t **m_paths;
+	paths_directory_t **m_directories;		// Index of each path, NULL if it is not indexed
+	int *m_fds;								// Directory fd of each path, PATHS_FD_NONE if it could not be opened
 	uint32_t m_paths_size;
 	uint32_t m_paths_count;
+	uint64_t generation;					// Changes whenever search paths change
+	uint64_t refresh_generation;			// Indexed directories are checked for changes once in it
+	cparserdictionary_t *resolutions;		// Resolutions by include spelling atom
 } cparserpaths_t;
 
 
+// Indexed directories by path atom, shared by every search paths object for the whole process
+static cparserdictionary_t *paths_directories = NULL;
+
+// Changes whenever a lookup finds a modified directory
+static uint64_t paths_index_generation = 0;
+
+// Last refresh generation given to a search paths object
+static uint64_t paths_refresh_generation = 0;
+
+
+static void PathsDeleteResolutions(cparserpaths_t *p)
+{
+	for (uint32_t i = 0; i < DictionaryGetKeyCount(p->resolutions); i++)
+		free((void *)DictionaryGetValueByIndex(p->resolutions, i));
+
+	DictionaryDelete(p->resolutions);
+}
+
+static uint8_t *PathsJoin(const uint8_t *path, const uint8_t *filename, uint32_t lf)
+{
+	uint32_t lp = strlen(_t path);
+	uint8_t *pc = malloc(sizeof(uint8_t) * (lp + 1 + lf + 1));
+
+	// Path, separator and filename with a null terminator
+	memcpy(pc, path, lp);
+	pc[lp] = '/';
+	memcpy(pc + lp + 1, filename, lf);
+	pc[lp + 1 + lf] = 0;
+
+	return pc;
+}
+
+static int PathsOpenDirectory(const uint8_t *path)
+{
+	// Directory handle only for lookups, files are opened relative to it
+	return open(_t path, O_PATH | O_DIRECTORY | O_CLOEXEC);
+}
+
+static int PathsOpenFlags(const uint8_t *mode)
+{
+	int flags;
+
+	// Same flags fopen uses for the mode
+	if (mode[0] == 'w')
+		flags = O_WRONLY | O_CREAT | O_TRUNC;
+	else if (mode[0] == 'a')
+		flags = O_WRONLY | O_CREAT | O_APPEND;
+	else
+		flags = O_RDONLY;
+
+	if (strchr(_t mode, '+'))
+		flags = (flags & ~O_WRONLY) | O_RDWR;
+
+	return flags | O_CLOEXEC;
+}
+
+static bool PathsHasDirectory(cparserpaths_t *p, uint32_t i)
+{
+	// Directories missing when added may exist now
+	if (p->m_fds[i] == PATHS_FD_NONE)
+		p->m_fds[i] = PathsOpenDirectory(p->m_paths[i]);
+
+	return (p->m_fds[i] != PATHS_FD_NONE);
+}
+
+static FILE *PathsOpenAt(cparserpaths_t *p, uint32_t i, const uint8_t *filename, const uint8_t *mode)
+{
+	FILE *f;
+	int fd;
+
+	if (!PathsHasDirectory(p, i))
+		return NULL;
+
+	// Open relative to the directory, the kernel does not walk its path again
+	fd = openat(p->m_fds[i], _t filename, PathsOpenFlags(mode), 0666);
+	if (fd < 0)
+		return NULL;
+
+	f = fdopen(fd, _t mode);
+	if (f == NULL)
+		close(fd);
+
+	return f;
+}
+
+static bool PathsProbeAt(cparserpaths_t *p, uint32_t i, const uint8_t *filename, const uint8_t *mode, FILE **f, struct stat *st)
+{
+	// Open the file, or only get its status if there is no mode
+	if (mode != NULL)
+	{
+		*f = PathsOpenAt(p, i, filename, mode);
+		return (*f != NULL);
+	}
+
+	return PathsHasDirectory(p, i) && (fstatat(p->m_fds[i], _t filename, st, 0) == 0);
+}
+
+static paths_directory_t *PathsGetDirectory(const uint8_t *path, uint32_t length)
+{
+	atom_t atom = AtomIntern(path, length);
+	paths_directory_t *pd;
+
+	if (paths_directories == NULL)
+		paths_directories = DictionaryNew();
+
+	// Directories are added unscanned, they live as long as the process
+	pd = (paths_directory_t *)DictionaryGetAtomValue(paths_directories, atom);
+	if (pd == NULL)
+	{
+		pd = malloc(sizeof(paths_directory_t));
+		pd->path = AtomGetString(atom);
+		pd->mtime.tv_sec = 0;
+		pd->mtime.tv_nsec = 0;
+		pd->checked = 0;
+		pd->entries = NULL;
+		DictionarySetAtomValue(paths_directories, atom, pd);
+	}
+
+	return pd;
+}
+
+static void PathsScanDirectory(paths_directory_t *pd)
+{
+	struct stat st;
+	struct dirent *de;
+	DIR *dir;
+
+	// Missing or unreadable directories have no entries
+	pd->entries = DictionaryNew();
+	pd->mtime.tv_sec = 0;
+	pd->mtime.tv_nsec = 0;
+	if ((stat(_t pd->path, &st) != 0) || ((dir = opendir(_t pd->path)) == NULL))
+		return;
+	pd->mtime = st.st_mtim;
+
+	while ((de = readdir(dir)) != NULL)
+	{
+		uintptr_t kind = PATHS_ENTRY_FILE;
+
+		if ((strcmp(de->d_name, ".") == 0) || (strcmp(de->d_name, "..") == 0))
+			continue;
+
+		// Links and entries of unknown type are classified by what they point to
+		if (de->d_type == DT_DIR)
+		{
+			kind = PATHS_ENTRY_DIRECTORY;
+		}
+		else if ((de->d_type == DT_LNK) || (de->d_type == DT_UNKNOWN))
+		{
+			if (fstatat(dirfd(dir), de->d_name, &st, 0) != 0)
+				continue;
+			kind = S_ISDIR(st.st_mode) ? PATHS_ENTRY_DIRECTORY : PATHS_ENTRY_FILE;
+		}
+
+		DictionarySetAtomValue(pd->entries, AtomIntern(_T de->d_name, strlen(de->d_name)), (const void *)kind);
+	}
+
+	closedir(dir);
+}
+
+static bool PathsRefreshDirectory(paths_directory_t *pd, uint64_t refresh)
+{
+	struct stat st;
+
+	// Check it once per refresh generation, misses in between trust the index
+	if (pd->checked == refresh)
+		return false;
+	pd->checked = refresh;
+
+	// Compare with the time it had, directories unreadable then have zero time
+	if (stat(_t pd->path, &st) != 0)
+	{
+		st.st_mtim.tv_sec = 0;
+		st.st_mtim.tv_nsec = 0;
+	}
+
+	if ((st.st_mtim.tv_sec == pd->mtime.tv_sec) && (st.st_mtim.tv_nsec == pd->mtime.tv_nsec))
+		return false;
+
+	// Scan it again, resolutions made with the former entries are outdated
+	DictionaryDelete(pd->entries);
+	PathsScanDirectory(pd);
+	paths_index_generation++;
+
+	return true;
+}
+
+static bool PathsIsIndexable(const uint8_t *filename)
+{
+	const uint8_t *s = filename;
+
+	// Absolute filenames and empty, dot and dot dot components are not looked up in the index
+	if (*s == '/')
+		return false;
+
+	while (*s)
+	{
+		const uint8_t *slash = _T strchr(_t s, '/');
+		uint32_t length = slash ? (uint32_t)(slash - s) : strlen(_t s);
+
+		if ((length == 0) || ((s[0] == '.') && ((length == 1) || ((length == 2) && (s[1] == '.')))))
+			return false;
+
+		s += length + (slash ? 1 : 0);
+	}
+
+	return true;
+}
+
+static uintptr_t PathsIndexGetEntry(paths_directory_t *pd, const uint8_t *name, uint32_t length)
+{
+	atom_t atom = AtomFind(name, length);
+
+	// Names never seen are in no directory
+	return (atom != ATOM_NONE) ? (uintptr_t)DictionaryGetAtomValue(pd->entries, atom) : PATHS_ENTRY_NONE;
+}
+
+static bool PathsIndexHasFile(paths_directory_t *pd, const uint8_t *filename, uint64_t refresh)
+{
+	const uint8_t *name = filename;
+
+	// Walk down subdirectories
+	while (true)
+	{
+		const uint8_t *slash = _T strchr(_t name, '/');
+		uint32_t length = slash ? (uint32_t)(slash - name) : strlen(_t name);
+		uintptr_t kind;
+		uint8_t *path;
+
+		if (pd->entries == NULL)
+		{
+			PathsScanDirectory(pd);
+			pd->checked = refresh;
+		}
+
+		// Entries are only missing if the directory did not change since it was scanned
+		kind = PathsIndexGetEntry(pd, name, length);
+		if ((kind != (slash ? PATHS_ENTRY_DIRECTORY : PATHS_ENTRY_FILE)) && PathsRefreshDirectory(pd, refresh))
+			kind = PathsIndexGetEntry(pd, name, length);
+
+		if (slash == NULL)
+			return (kind == PATHS_ENTRY_FILE);
+		else if (kind != PATHS_ENTRY_DIRECTORY)
+			return false;
+
+		path = PathsJoin(pd->path, name, length);
+		pd = PathsGetDirectory(path, strlen(_t path));
+		free(path);
+		name = slash + 1;
+	}
+}
+
+static void PathsAppend(cparserpaths_t *p, const uint8_t *path, paths_directory_t *pd)
+{
+	if (p->m_paths_count == p->m_paths_size)
+	{
+		// Create new size and paths arrays
+		uint32_t ss = p->m_paths_count + ARRAY_GROWTH_SPEED;
+		const uint8_t **pp = (const uint8_t **) malloc(sizeof(uint8_t *) * ss);
+		paths_directory_t **dd = malloc(sizeof(paths_directory_t *) * ss);
+		int *ff = malloc(sizeof(int) * ss);
+
+		// Copy to new paths arrays and delete the old ones
+		if (p->m_paths_count > 0)
+		{
+			memcpy(pp, p->m_paths, sizeof(uint8_t *) * p->m_paths_count);
+			memcpy(dd, p->m_directories, sizeof(paths_directory_t *) * p->m_paths_count);
+			memcpy(ff, p->m_fds, sizeof(int) * p->m_paths_count);
+		}
+		free(p->m_paths);
+		free(p->m_directories);
+		free(p->m_fds);
+
+		// Assing the new size and paths arrays
+		p->m_paths = pp;
+		p->m_directories = dd;
+		p->m_fds = ff;
+		p->m_paths_size = ss;
+	}
+
+	// Add the new path, former resolutions are outdated
+	p->m_directories[p->m_paths_count] = pd;
+	p->m_fds[p->m_paths_count] = PathsOpenDirectory(path);
+	p->m_paths[p->m_paths_count++] = _T strdup(_t path);
+	p->generation++;
+}
+
 cparserpaths_t *PathsNew(void)
 {
 	cparserpaths_t *res = malloc(sizeof(cparserpaths_t));
 
 	// Initialize structure
 	res->m_paths = NULL;
+	res->m_directories = NULL;
+	res->m_fds = NULL;
 	res->m_paths_size = 0;
 	res->m_paths_count = 0;
+	res->generation = 0;
+	res->refresh_generation = ++paths_refresh_generation;
+	res->resolutions = DictionaryNew();
 
 	return res;
 }
@@ -38,44 +371,79 @@ cparserpaths_t *PathsClone(cparserpaths_t *p)
 {
 	cparserpaths_t *res = malloc(sizeof(cparserpaths_t));
 
-	// Copy already defined structure
+	// Copy already defined structure, directory indexes are shared and directory fds duplicated
 	res->m_paths = (const uint8_t **) malloc(sizeof(uint8_t *) * p->m_paths_size);
+	res->m_directories = malloc(sizeof(paths_directory_t *) * p->m_paths_size);
+	res->m_fds = malloc(sizeof(int) * p->m_paths_size);
 	res->m_paths_size = p->m_paths_size;
 	for (res->m_paths_count = 0; res->m_paths_count < p->m_paths_count; res->m_paths_count++)
-		res->m_paths[res->m_paths_count] = _T strdup(_t p->m_paths[res->m_paths_count]);
+	{
+		uint32_t i = res->m_paths_count;
+
+		res->m_paths[i] = _T strdup(_t p->m_paths[i]);
+		res->m_directories[i] = p->m_directories[i];
+		res->m_fds[i] = (p->m_fds[i] == PATHS_FD_NONE) ? PATHS_FD_NONE : fcntl(p->m_fds[i], F_DUPFD_CLOEXEC, 0);
+	}
+
+	// Clone resolves its includes again, it may get different search paths, and sees directory changes
+	res->generation = 0;
+	res->refresh_generation = ++paths_refresh_generation;
+	res->resolutions = DictionaryNew();
 
 	return res;
 }
 
 void PathsDelete(cparserpaths_t *p)
 {
-	// Delete paths
+	// Delete paths and close their directories
 	while (p->m_paths_count--)
+	{
 		free((void *)p->m_paths[p->m_paths_count]);
+		if (p->m_fds[p->m_paths_count] != PATHS_FD_NONE)
+			close(p->m_fds[p->m_paths_count]);
+	}
 
-	// Delete paths array
+	// Delete paths arrays, resolutions and structure
 	free(p->m_paths);
+	free(p->m_directories);
+	free(p->m_fds);
+	PathsDeleteResolutions(p);
+	free(p);
 }
 
 void PathsAddPath(cparserpaths_t *p, const uint8_t *path)
 {
-	if (p->m_paths_count == p->m_paths_size)
-	{
-		// Create new size and paths array
-		uint32_t ss = p->m_paths_count + ARRAY_GROWTH_SPEED;
-		const uint8_t **pp = (const uint8_t **) malloc(sizeof(uint8_t) *ss);
-
-		// Copy to new paths array and delete the old one
-		memcpy(pp, p->m_paths, sizeof(uint8_t *) * p->m_paths_count);
-		free(p->m_paths);
+	PathsAppend(p, path, NULL);
+}
 
-		// Assing the new size and paths array
-		p->m_paths = pp;
-		p->m_paths_size = ss;
-	}
+/**
+ * Adds a search path whose directory tree is indexed in memory
+ *
+ * Each directory is scanned the first time a lookup goes through it, files
+ * missing from the index are never opened. A lookup missing a name checks the
+ * modification time of the directory first, and scans it again if it changed.
+ * Each directory is checked once until the search paths are refreshed, see
+ * PathsRefresh. Indexes are shared by every search paths object of the process.
+ *
+ * \param[in]	p:		search paths
+ * \param[in]	path:	directory to add
+ */
+void PathsAddIndexedPath(cparserpaths_t *p, const uint8_t *path)
+{
+	PathsAppend(p, path, PathsGetDirectory(path, strlen(_t path)));
+}
 
-	// Add the new path
-	p->m_paths[p->m_paths_count++] = _T strdup(_t path);
+/**
+ * Makes search paths see the files added or removed since they were created or last refreshed
+ *
+ * Includes are resolved again, and indexed directories are checked for changes once more.
+ *
+ * \param[in]	p:	search paths
+ */
+void PathsRefresh(cparserpaths_t *p)
+{
+	p->refresh_generation = ++paths_refresh_generation;
+	p->generation++;
 }
 
 uint32_t PathsGetPathsCount(cparserpaths_t *p)
@@ -91,47 +459,109 @@ const uint8_t * PathsGetPathByIndex(cparserpaths_t *p, uint32_t i)
 	return p->m_paths[i];
 }
 
-FILE * PathsOpenFile(const cparserpaths_t *p, const uint8_t *filename, const uint8_t *mode)
+static bool PathsResolve(cparserpaths_t *p, const uint8_t *filename, const uint8_t *mode, FILE **f, struct stat *st)
 {
-	char *pc;
-	uint32_t lp, lf;
-	FILE *f;
+	paths_resolution_t *pr;
+	atom_t atom;
+	bool indexable;
+	bool found = false;
 
 	// Check filename
 	if (!filename)
-		return NULL;
+		return false;
+
+	// Probe the cached resolution, if the file is gone resolve it again
+	atom = AtomIntern(filename, strlen(_t filename));
+	pr = (paths_resolution_t *)DictionaryGetAtomValue(p->resolutions, atom);
+	if ((pr != NULL) && (pr->generation == p->generation) && (pr->index_generation == paths_index_generation))
+	{
+		if (pr->index == PATHS_INDEX_NONE)
+			return false;
+
+		if (PathsProbeAt(p, pr->index, filename, mode, f, st))
+			return true;
+	}
 
-	for (uint32_t i = 0; (f == NULL) && (i < p->m_paths_count); i++)
+	if (pr == NULL)
 	{
-		// Get path and filename lengths
-		lp = strlen(_t p->m_paths[i]);
-		lf = strlen(_t filename);
+		pr = malloc(sizeof(paths_resolution_t));
+		DictionarySetAtomValue(p->resolutions, atom, pr);
+	}
 
-		// Get full filename path
-		pc = malloc(sizeof(char) * (lp + 1 + lf + 1));
-		strcpy(pc, _t p->m_paths[i]);
-		strcat(pc, _t "/");
-		strcat(pc, _t filename);
+	pr->generation = p->generation;
+	pr->index_generation = paths_index_generation;
+	pr->index = PATHS_INDEX_NONE;
 
-		// Open file;
-		f = fopen(pc, _t mode);
+	indexable = PathsIsIndexable(filename);
+	for (uint32_t i = 0; !found && (i < p->m_paths_count); i++)
+	{
+		// Skip indexed paths without the file
+		if (indexable && (p->m_directories[i] != NULL) && !PathsIndexHasFile(p->m_directories[i], filename, p->refresh_generation))
+			continue;
 
-		// Delete filename path
-		free(pc);
+		// Keep the path it was found at
+		found = PathsProbeAt(p, i, filename, mode, f, st);
+		if (found)
+			pr->index = i;
 	}
 
+	return found;
+}
+
+/**
+ * Opens a file looking for it in the search paths in order
+ *
+ * Files are opened relative to the directory fd of each search path.
+ * Resolutions are cached by filename until search paths change, so an already
+ * resolved filename costs one lookup and one open, and a missing one no open.
+ * Indexed search paths are only tried if their index has the file.
+ *
+ * \param[in]	p:			search paths
+ * \param[in]	filename:	filename relative to the search paths
+ * \param[in]	mode:		fopen mode
+ *
+ * \return opened file, NULL if not found in any search path
+ */
+FILE * PathsOpenFile(cparserpaths_t *p, const uint8_t *filename, const uint8_t *mode)
+{
+	FILE *f = NULL;
+
+	PathsResolve(p, filename, mode, &f, NULL);
+
 	return f;
 }
 
+/**
+ * Gets the status of the file PathsOpenFile would open, without opening it
+ *
+ * \param[in]	p:			search paths
+ * \param[in]	filename:	filename relative to the search paths
+ * \param[out]	st:			file status
+ *
+ * \return false if not found in any search path
+ */
+bool PathsStatFile(cparserpaths_t *p, const uint8_t *filename, struct stat *st)
+{
+	return PathsResolve(p, filename, NULL, NULL, st);
+}
+
 void PathsDeletePathByIndex(cparserpaths_t *p, uint32_t i)
 {
 	if (i >= p->m_paths_count)
 		return;
 
-	// Delete path string and move back the rest all
+	// Delete path string, close its directory and move back the rest all
 	free((void *)p->m_paths[i]);
+	if (p->m_fds[i] != PATHS_FD_NONE)
+		close(p->m_fds[i]);
 	p->m_paths_count--;
 	for (; i < p->m_paths_count; i++)
+	{
 		p->m_paths[i] = p->m_paths[i + 1];
-}
+		p->m_directories[i] = p->m_directories[i + 1];
+		p->m_fds[i] = p->m_fds[i + 1];
+	}
 
+	// Former resolutions are outdated
+	p->generation++;
+}
@@ -11,15 +11,19 @@
 
 struct cparserpaths_s;
 typedef struct cparserpaths_s cparserpaths_t;
+struct stat;
 
 
 cparserpaths_t *PathsNew(void);
 cparserpaths_t *PathsClone(cparserpaths_t *p);
 void PathsDelete(cparserpaths_t *p);
 void PathsAddPath(cparserpaths_t *p, const uint8_t *path);
+void PathsAddIndexedPath(cparserpaths_t *p, const uint8_t *path);
+void PathsRefresh(cparserpaths_t *p);
 uint32_t PathsGetPathsCount(cparserpaths_t *p);
 const uint8_t * PathsGetPathByIndex(cparserpaths_t *p, uint32_t i);
-FILE * PathsOpenFile(const cparserpaths_t *p, const uint8_t *filename, const uint8_t *mode);
+FILE * PathsOpenFile(cparserpaths_t *p, const uint8_t *filename, const uint8_t *mode);
+bool PathsStatFile(cparserpaths_t *p, const uint8_t *filename, struct stat *st);
 void PathsDeletePathByIndex(cparserpaths_t *p, uint32_t i);
 
 
@@ -0,0 +1,376 @@
+/*
+ * cparserscan.c
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <pthread.h>
+#include "cparserscan.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCAN_X86
+#endif
+
+
+// Scanning kernels, chosen at runtime depending on the CPU
+typedef struct scan_kernels_s
+{
+	const uint8_t *(*identifier)(const uint8_t *p, const uint8_t *end);
+	const uint8_t *(*empty)(const uint8_t *p, const uint8_t *end);
+	const uint8_t *(*c_comment_end)(const uint8_t *p, const uint8_t *end);
+	const uint8_t *(*inactive)(const uint8_t *p, const uint8_t *end);
+	uint32_t (*count_newlines)(const uint8_t *p, const uint8_t *end);
+} scan_kernels_t;
+
+
+static inline bool IsIdentifierChar(uint8_t c)
+{
+	return 	((uint8_t)((c | 0x20) - 'a') <= 'z' - 'a') ||
+			((uint8_t)(c - '0') <= '9' - '0') ||
+			(c == '_');
+}
+
+static inline bool IsEmptyChar(uint8_t c)
+{
+	return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+}
+
+static inline bool IsInactiveStopChar(uint8_t c)
+{
+	return (c == '\n') || (c == '/') || (c == '\"') || (c == '\'') || (c == '\\');
+}
+
+static const uint8_t *ScalarIdentifier(const uint8_t *p, const uint8_t *end)
+{
+	while (p < end && IsIdentifierChar(*p))
+		p++;
+
+	return p;
+}
+
+static const uint8_t *ScalarEmpty(const uint8_t *p, const uint8_t *end)
+{
+	while (p < end && IsEmptyChar(*p))
+		p++;
+
+	return p;
+}
+
+static const uint8_t *ScalarCCommentEnd(const uint8_t *p, const uint8_t *end)
+{
+	while (p + 1 < end && !(p[0] == '*' && p[1] == '/'))
+		p++;
+
+	return (p + 1 < end) ? p : end;
+}
+
+static const uint8_t *ScalarInactive(const uint8_t *p, const uint8_t *end)
+{
+	while (p < end && !IsInactiveStopChar(*p))
+		p++;
+
+	return p;
+}
+
+static uint32_t ScalarCountNewlines(const uint8_t *p, const uint8_t *end)
+{
+	uint32_t count = 0;
+
+	while ((p = memchr(p, '\n', end - p)) != NULL)
+	{
+		count++;
+		p++;
+	}
+
+	return count;
+}
+
+static const scan_kernels_t scalar_kernels =
+{
+	ScalarIdentifier, ScalarEmpty, ScalarCCommentEnd, ScalarInactive, ScalarCountNewlines
+};
+
+#ifdef SCAN_X86
+
+// Bytes in [lo, hi] using a signed compare on the bytes shifted by 0x80 - lo
+#define SSE2_IN_RANGE(v, lo, hi)	_mm_cmplt_epi8(_mm_add_epi8((v), _mm_set1_epi8((char)(0x80 - (lo)))), _mm_set1_epi8((char)(0x80 + (hi) - (lo) + 1)))
+#define AVX2_IN_RANGE(v, lo, hi)	_mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + (hi) - (lo) + 1)), _mm256_add_epi8((v), _mm256_set1_epi8((char)(0x80 - (lo)))))
+
+static inline uint32_t Sse2IdentifierMask(__m128i v)
+{
+	__m128i letter = SSE2_IN_RANGE(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z');
+	__m128i digit = SSE2_IN_RANGE(v, '0', '9');
+	__m128i underscore = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+
+	return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(letter, digit), underscore));
+}
+
+static inline uint32_t Sse2EmptyMask(__m128i v)
+{
+	__m128i space = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+	__m128i newline = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+
+	return _mm_movemask_epi8(_mm_or_si128(space, newline));
+}
+
+static inline uint32_t Sse2InactiveStopMask(__m128i v)
+{
+	__m128i line = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+	__m128i quote = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\'')));
+
+	return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(line, quote), _mm_cmpeq_epi8(v, _mm_set1_epi8('/'))));
+}
+
+static const uint8_t *Sse2Identifier(const uint8_t *p, const uint8_t *end)
+{
+	// Look for the first non identifier char 16 bytes at a time
+	while (p + 16 <= end)
+	{
+		uint32_t mask = ~Sse2IdentifierMask(_mm_loadu_si128((const __m128i *)p)) & 0xFFFF;
+		if (mask)
+			return p + __builtin_ctz(mask);
+		p += 16;
+	}
+
+	return ScalarIdentifier(p, end);
+}
+
+static const uint8_t *Sse2Empty(const uint8_t *p, const uint8_t *end)
+{
+	// Look for the first non empty char 16 bytes at a time
+	while (p + 16 <= end)
+	{
+		uint32_t mask = ~Sse2EmptyMask(_mm_loadu_si128((const __m128i *)p)) & 0xFFFF;
+		if (mask)
+			return p + __builtin_ctz(mask);
+		p += 16;
+	}
+
+	return ScalarEmpty(p, end);
+}
+
+static const uint8_t *Sse2CCommentEnd(const uint8_t *p, const uint8_t *end)
+{
+	// Look for a star followed by a slash 16 bytes at a time
+	while (p + 17 <= end)
+	{
+		__m128i star = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)p), _mm_set1_epi8('*'));
+		__m128i slash = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + 1)), _mm_set1_epi8('/'));
+		uint32_t mask = _mm_movemask_epi8(_mm_and_si128(star, slash));
+		if (mask)
+			return p + __builtin_ctz(mask);
+		p += 16;
+	}
+
+	return ScalarCCommentEnd(p, end);
+}
+
+static const uint8_t *Sse2Inactive(const uint8_t *p, const uint8_t *end)
+{
+	// Look for the first char that changes the state of an inactive line 16 bytes at a time
+	while (p + 16 <= end)
+	{
+		uint32_t mask = Sse2InactiveStopMask(_mm_loadu_si128((const __m128i *)p));
+		if (mask)
+			return p + __builtin_ctz(mask);
+		p += 16;
+	}
+
+	return ScalarInactive(p, end);
+}
+
+static uint32_t Sse2CountNewlines(const uint8_t *p, const uint8_t *end)
+{
+	uint32_t count = 0;
+
+	// Count new lines 16 bytes at a time
+	while (p + 16 <= end)
+	{
+		count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)p), _mm_set1_epi8('\n'))));
+		p += 16;
+	}
+
+	return count + ScalarCountNewlines(p, end);
+}
+
+__attribute__((target("avx2")))
+static inline uint32_t Avx2IdentifierMask(__m256i v)
+{
+	__m256i letter = AVX2_IN_RANGE(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z');
+	__m256i digit = AVX2_IN_RANGE(v, '0', '9');
+	__m256i underscore = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+
+	return _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(letter, digit), underscore));
+}
+
+__attribute__((target("avx2")))
+static inline uint32_t Avx2EmptyMask(__m256i v)
+{
+	__m256i space = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+	__m256i newline = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+
+	return _mm256_movemask_epi8(_mm256_or_si256(space, newline));
+}
+
+__attribute__((target("avx2")))
+static inline uint32_t Avx2InactiveStopMask(__m256i v)
+{
+	__m256i line = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+	__m256i quote = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\'')));
+
+	return _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(line, quote), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/'))));
+}
+
+__attribute__((target("avx2")))
+static const uint8_t *Avx2Identifier(const uint8_t *p, const uint8_t *end)
+{
+	// Look for the first non identifier char 32 bytes at a time
+	while (p + 32 <= end)
+	{
+		uint32_t mask = ~Avx2IdentifierMask(_mm256_loadu_si256((const __m256i *)p));
+		if (mask)
+			return p + __builtin_ctz(mask);
+		p += 32;
+	}
+
+	return Sse2Identifier(p, end);
+}
+
+__attribute__((target("avx2")))
+static const uint8_t *Avx2Empty(const uint8_t *p, const uint8_t *end)
+{
+	// Look for the first non empty char 32 bytes at a time
+	while (p + 32 <= end)
+	{
+		uint32_t mask = ~Avx2EmptyMask(_mm256_loadu_si256((const __m256i *)p));
+		if (mask)
+			return p + __builtin_ctz(mask);
+		p += 32;
+	}
+
+	return Sse2Empty(p, end);
+}
+
+__attribute__((target("avx2")))
+static const uint8_t *Avx2CCommentEnd(const uint8_t *p, const uint8_t *end)
+{
+	// Look for a star followed by a slash 32 bytes at a time
+	while (p + 33 <= end)
+	{
+		__m256i star = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)p), _mm256_set1_epi8('*'));
+		__m256i slash = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + 1)), _mm256_set1_epi8('/'));
+		uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(star, slash));
+		if (mask)
+			return p + __builtin_ctz(mask);
+		p += 32;
+	}
+
+	return Sse2CCommentEnd(p, end);
+}
+
+__attribute__((target("avx2")))
+static const uint8_t *Avx2Inactive(const uint8_t *p, const uint8_t *end)
+{
+	// Look for the first char that changes the state of an inactive line 32 bytes at a time
+	while (p + 32 <= end)
+	{
+		uint32_t mask = Avx2InactiveStopMask(_mm256_loadu_si256((const __m256i *)p));
+		if (mask)
+			return p + __builtin_ctz(mask);
+		p += 32;
+	}
+
+	return Sse2Inactive(p, end);
+}
+
+__attribute__((target("avx2,popcnt")))
+static uint32_t Avx2CountNewlines(const uint8_t *p, const uint8_t *end)
+{
+	uint32_t count = 0;
+
+	// Count new lines 32 bytes at a time
+	while (p + 32 <= end)
+	{
+		count += __builtin_popcount(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)p), _mm256_set1_epi8('\n'))));
+		p += 32;
+	}
+
+	return count + Sse2CountNewlines(p, end);
+}
+
+static const scan_kernels_t sse2_kernels =
+{
+	Sse2Identifier, Sse2Empty, Sse2CCommentEnd, Sse2Inactive, Sse2CountNewlines
+};
+
+static const scan_kernels_t avx2_kernels =
+{
+	Avx2Identifier, Avx2Empty, Avx2CCommentEnd, Avx2Inactive, Avx2CountNewlines
+};
+
+#endif
+
+static const scan_kernels_t *kernels = NULL;
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+static void KernelsSelect(void)
+{
+#ifdef SCAN_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+		kernels = &avx2_kernels;
+	else if (__builtin_cpu_supports("sse2"))
+		kernels = &sse2_kernels;
+	else
+		kernels = &scalar_kernels;
+#else
+	kernels = &scalar_kernels;
+#endif
+}
+
+static const scan_kernels_t *Kernels(void)
+{
+	// Select kernels once, chunk lexing threads may request them at the same time
+	pthread_once(&kernels_once, KernelsSelect);
+
+	return kernels;
+}
+
+const uint8_t *ScanIdentifier(const uint8_t *p, const uint8_t *end)
+{
+	return Kernels()->identifier(p, end);
+}
+
+const uint8_t *ScanEmpty(const uint8_t *p, const uint8_t *end)
+{
+	return Kernels()->empty(p, end);
+}
+
+const uint8_t *ScanCCommentEnd(const uint8_t *p, const uint8_t *end)
+{
+	return Kernels()->c_comment_end(p, end);
+}
+
+const uint8_t *ScanInactive(const uint8_t *p, const uint8_t *end)
+{
+	return Kernels()->inactive(p, end);
+}
+
+const uint8_t *ScanNewline(const uint8_t *p, const uint8_t *end)
+{
+	// glibc memchr is already vectorized
+	const uint8_t *q = memchr(p, '\n', end - p);
+
+	return (q != NULL) ? q : end;
+}
+
+uint32_t ScanCountNewlines(const uint8_t *p, const uint8_t *end)
+{
+	return Kernels()->count_newlines(p, end);
+}
@@ -0,0 +1,20 @@
+/*
+ * cparserscan.h
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#ifndef CPARSER_CPARSERSCAN_H_
+#define CPARSER_CPARSERSCAN_H_
+
+
+const uint8_t *ScanIdentifier(const uint8_t *p, const uint8_t *end);
+const uint8_t *ScanEmpty(const uint8_t *p, const uint8_t *end);
+const uint8_t *ScanCCommentEnd(const uint8_t *p, const uint8_t *end);
+const uint8_t *ScanInactive(const uint8_t *p, const uint8_t *end);
+const uint8_t *ScanNewline(const uint8_t *p, const uint8_t *end);
+uint32_t ScanCountNewlines(const uint8_t *p, const uint8_t *end);
+
+
+#endif /* CPARSER_CPARSERSCAN_H_ */
@@ -7,39 +7,127 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <cparsertools.h>
 #include <cparsertoken.h>
+#include <cparserscan.h>
+#include <cparserkeyword.h>
+#include <cparseratom.h>
 
 
 typedef bool (*acceptance_filter_callback_t)(uint16_t last_char, uint32_t length, uint8_t *end);
+typedef const uint8_t *(*scan_callback_t)(const uint8_t *first, const uint8_t *p, const uint8_t *limit);
+
+// Token string buffers released by TokenDelete are kept per thread to be reused by the next TokenNew
+typedef struct str_pool_s
+{
+	uint8_t *str[CPARSER_TOKEN_STR_POOL_SIZE];
+	uint32_t str_size[CPARSER_TOKEN_STR_POOL_SIZE];
+	uint32_t count;
+} str_pool_t;
 
 
-//static const uint8_t * set_valid_chars = _T "_abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 \t\r\n+-*/=\\\"'^&|~!?:;,.><#()[]{}";
-static const uint8_t * set_empty_chars = _T " \t\r\n";
-static const uint8_t * set_lead_identifier_chars = _T "_abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
-static const uint8_t * set_identifier_chars = _T "_abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
-static const uint8_t * set_lead_number_literal_chars = _T "01234567890";
-static const uint8_t * set_number_literal_chars = _T "0123456789xXbB.fFeEuUlL";
-static const uint8_t * set_dual_operator_chars = _T "+-=&|><";
-static const uint8_t * set_single_operator_chars = _T "*%^~!";
-static const uint8_t * set_single_char_token_chars = _T "?:;,.#()[]{}";
+// Character classes
+#define CHAR_CLASS_EMPTY					0x01
+#define CHAR_CLASS_LEAD_IDENTIFIER			0x02
+#define CHAR_CLASS_IDENTIFIER				0x04
+#define CHAR_CLASS_LEAD_NUMBER_LITERAL		0x08
+#define CHAR_CLASS_NUMBER_LITERAL			0x10
+#define CHAR_CLASS_LETTER					(CHAR_CLASS_LEAD_IDENTIFIER | CHAR_CLASS_IDENTIFIER)
+#define CHAR_CLASS_NUMBER_LETTER			(CHAR_CLASS_LETTER | CHAR_CLASS_NUMBER_LITERAL)
+#define CHAR_CLASS_DIGIT					(CHAR_CLASS_IDENTIFIER | CHAR_CLASS_LEAD_NUMBER_LITERAL | CHAR_CLASS_NUMBER_LITERAL)
 
 
-static bool CharInSet(uint8_t c, const uint8_t *set)
+// Lexer state selected by the first char of a token
+typedef enum lexer_state_e
+{
+	LEXER_STATE_INVALID = 0,
+	LEXER_STATE_SINGLE_CHAR,
+	LEXER_STATE_IDENTIFIER,
+	LEXER_STATE_NUMBER_LITERAL,
+	LEXER_STATE_STRING_LITERAL,
+	LEXER_STATE_CHAR_LITERAL,
+	LEXER_STATE_DUAL_OPERATOR,
+	LEXER_STATE_SINGLE_OPERATOR,
+	LEXER_STATE_SLASH,
+	LEXER_STATE_BACKSLASH
+} lexer_state_t;
+
+
+// Classes of each char, EOF is looked up as 0xFF so it has no class
+static const uint8_t char_class[256] =
+{
+	[' '] = CHAR_CLASS_EMPTY, ['\t'] = CHAR_CLASS_EMPTY, ['\r'] = CHAR_CLASS_EMPTY, ['\n'] = CHAR_CLASS_EMPTY,
+	['0' ... '9'] = CHAR_CLASS_DIGIT,
+	['.'] = CHAR_CLASS_NUMBER_LITERAL,
+	// Number literals take every identifier char like preprocessing numbers, decoding validates them
+	['_'] = CHAR_CLASS_NUMBER_LETTER,
+	['a' ... 'z'] = CHAR_CLASS_NUMBER_LETTER,
+	['A' ... 'Z'] = CHAR_CLASS_NUMBER_LETTER
+};
+
+// Lexer state for the first char of a token, EOF is looked up as 0xFF so it is invalid
+static const uint8_t lexer_start_state[256] =
+{
+	['?'] = LEXER_STATE_SINGLE_CHAR, [':'] = LEXER_STATE_SINGLE_CHAR, [';'] = LEXER_STATE_SINGLE_CHAR,
+	[','] = LEXER_STATE_SINGLE_CHAR, ['.'] = LEXER_STATE_SINGLE_CHAR, ['#'] = LEXER_STATE_SINGLE_CHAR,
+	['('] = LEXER_STATE_SINGLE_CHAR, [')'] = LEXER_STATE_SINGLE_CHAR, ['['] = LEXER_STATE_SINGLE_CHAR,
+	[']'] = LEXER_STATE_SINGLE_CHAR, ['{'] = LEXER_STATE_SINGLE_CHAR, ['}'] = LEXER_STATE_SINGLE_CHAR,
+	['_'] = LEXER_STATE_IDENTIFIER, ['a' ... 'z'] = LEXER_STATE_IDENTIFIER, ['A' ... 'Z'] = LEXER_STATE_IDENTIFIER,
+	['0' ... '9'] = LEXER_STATE_NUMBER_LITERAL,
+	['\"'] = LEXER_STATE_STRING_LITERAL,
+	['\''] = LEXER_STATE_CHAR_LITERAL,
+	['+'] = LEXER_STATE_DUAL_OPERATOR, ['-'] = LEXER_STATE_DUAL_OPERATOR, ['='] = LEXER_STATE_DUAL_OPERATOR,
+	['&'] = LEXER_STATE_DUAL_OPERATOR, ['|'] = LEXER_STATE_DUAL_OPERATOR, ['>'] = LEXER_STATE_DUAL_OPERATOR,
+	['<'] = LEXER_STATE_DUAL_OPERATOR,
+	['*'] = LEXER_STATE_SINGLE_OPERATOR, ['%'] = LEXER_STATE_SINGLE_OPERATOR, ['^'] = LEXER_STATE_SINGLE_OPERATOR,
+	['~'] = LEXER_STATE_SINGLE_OPERATOR, ['!'] = LEXER_STATE_SINGLE_OPERATOR,
+	['/'] = LEXER_STATE_SLASH,
+	['\\'] = LEXER_STATE_BACKSLASH
+};
+
+
+static __thread str_pool_t str_pool;
+
+
+#define CharClass(c)		(char_class[(uint8_t)(c)])
+
+static bool FillWindow(token_source_t *source)
 {
-	while (*set)
-		if (c == *set++)
-			return true;
+	size_t length;
 
-	return false;
+	// Memory buffers cannot be refilled
+	if (source->read_block == NULL)
+		return false;
+
+	// Refill the window from the beginning
+	source->base_offset += source->end - source->base;
+	length = source->read_block(source->from, source->window, CPARSER_TOKEN_SOURCE_WINDOW_SIZE);
+	source->cursor = source->window;
+	source->end = source->window + length;
+
+	return length > 0;
 }
 
 static void NextChar(token_source_t *source)
 {
-	source->last_char = source->read(source->from);
+	// Walk the memory buffer or window, or request next byte to the read callback
+	if (source->read != NULL)
+	{
+		source->last_char = source->read(source->from);
+		source->base_offset += source->last_char != EOF;
+	}
+	else if ((source->cursor < source->end) || FillWindow(source))
+		source->last_char = *source->cursor++;
+	else
+		source->last_char = EOF;
+
+	// Rows and columns are computed later from a line index in lazy mode
+	if (source->lazy_positions)
+		return;
 
 	if (source->last_char == '\n')
 	{
@@ -52,21 +140,86 @@ static void NextChar(token_source_t *source)
 	}
 }
 
-static bool ParseIncludeAcceptanceFilter(uint16_t last_char, uint32_t length, uint8_t *end)
+static inline bool SourceIsMemory(token_source_t *source)
 {
-	return 	(length > 0 && *(end - 1) != '\n' && *(end - 1) != '>') ||
-			(length > 1 && *(end - 1) == '\n' && *(end - 2) == '\\') ||
-			(length > 2 && *(end - 1) == '\n' && *(end - 2) == '\r' && *(end - 3) == '\\');
+	return (source->read == NULL) && (source->read_block == NULL);
+}
+
+static inline uint32_t SourceOffset(token_source_t *source)
+{
+	// Offset of the current char in the input
+	if (source->read != NULL)
+		return source->base_offset - 1;
+
+	return source->base_offset + (source->cursor - 1 - source->base);
+}
+
+static inline void TokenSetPosition(token_t *tt, token_source_t *source)
+{
+	tt->row = source->row;
+	tt->column = source->column;
+	tt->offset = SourceOffset(source);
+}
+
+static void SkipTo(token_source_t *source, const uint8_t *q)
+{
+	// Account rows and columns of the bytes skipped up to q, lazy mode computes them later
+	if (!source->lazy_positions)
+	{
+		uint32_t rows = ScanCountNewlines(source->cursor, q);
+
+		if (rows == 0)
+		{
+			source->column += q - source->cursor;
+		}
+		else
+		{
+			const uint8_t *nl = q - 1;
+
+			// Columns restart after the last new line
+			while (*nl != '\n')
+				nl--;
+			source->row += rows;
+			source->column = q - nl;
+		}
+	}
+
+	// Byte at q becomes the current char
+	source->cursor = q;
+	NextChar(source);
 }
 
-static bool ParseIdentifierAcceptanceFilter(uint16_t last_char, uint32_t length, uint8_t *end)
+static const uint8_t *ScanIdentifierRun(const uint8_t *first, const uint8_t *p, const uint8_t *limit)
 {
-	return 	CharInSet(last_char, set_identifier_chars);
+	return ScanIdentifier(p, limit);
 }
 
-static bool ParseNumberLiteralAcceptanceFilter(uint16_t last_char, uint32_t length, uint8_t *end)
+static const uint8_t *ScanCComment(const uint8_t *first, const uint8_t *p, const uint8_t *limit)
 {
-	return 	CharInSet(last_char, set_number_literal_chars);
+	const uint8_t *q = ScanCCommentEnd(p, limit);
+
+	// Comment includes the terminator, or runs up to the limit
+	return (q < limit) ? q + 2 : limit;
+}
+
+static const uint8_t *ScanLine(const uint8_t *first, const uint8_t *p, const uint8_t *limit)
+{
+	// Look for the first new line not escaped with a backslash
+	while ((p = ScanNewline(p, limit)) < limit)
+	{
+		if (!(p - 1 >= first && p[-1] == '\\') && !(p - 2 >= first && p[-1] == '\r' && p[-2] == '\\'))
+			break;
+		p++;
+	}
+
+	return p;
+}
+
+static bool ParseIncludeAcceptanceFilter(uint16_t last_char, uint32_t length, uint8_t *end)
+{
+	return 	(length > 0 && *(end - 1) != '\n' && *(end - 1) != '>') ||
+			(length > 1 && *(end - 1) == '\n' && *(end - 2) == '\\') ||
+			(length > 2 && *(end - 1) == '\n' && *(end - 2) == '\r' && *(end - 3) == '\\');
 }
 
 static bool ParseStringLiteralAcceptanceFilter(uint16_t last_char, uint32_t length, uint8_t *end)
@@ -107,51 +260,111 @@ static bool ParseBackSlashAcceptanceFilter(uint16_t last_char, uint32_t length,
 	return last_char != '\n';
 }
 
+static void TokenStrGrow(token_t *tt, uint32_t length)
+{
+	// Double the string buffer until length plus the string end fits in
+	while (tt->str_size < length + 1)
+		tt->str_size *= 2;
+
+	tt->str = realloc(tt->str, tt->str_size);
+}
+
 /**
  * Digests a string from a file
  *
- * \param[in]		f: 		File from which to digest characters
- * \param[in/out] 	row:	row in text file
- * \param[in/out]	column:	column in text file
- * \param[out]		str:	string buffer to put the digested bytes
- * \param[in]		filter:	Filter that returns true if the byte processed is valid
+ * When the source is a memory buffer that is never refilled the digested bytes are left in place, and
+ * the token slice points to them. Otherwise they are copied into the token string.
+ *
+ * \param[in/out] 	source:	Token source from which to digest characters
+ * \param[out]		tt:		token whose slice or string buffer receives the digested bytes
+ * \param[in]		offset:	number of bytes already in the token before the digested ones
+ * \param[in]		run:	Char classes accepted without calling filter, 0 if none
+ * \param[in]		filter:	Filter that returns true if the byte processed is valid, NULL if only run is accepted
+ * \param[in]		scan:	Scanner that finds the end of the same bytes in a memory buffer, NULL if none
  */
-static void ParseDigestString(token_source_t *source, uint8_t *str, acceptance_filter_callback_t filter)
+static inline void ParseDigestString(token_source_t *source, token_t *tt, uint32_t offset, uint8_t run, acceptance_filter_callback_t filter, scan_callback_t scan)
 {
-	uint8_t *p = str;
+	uint32_t length = 0;
+
+	if (SourceIsMemory(source))
+	{
+		// Token bytes are contiguous in memory, current char is the one before cursor
+		const uint8_t *start = source->cursor - 1 - offset;
+
+		// Find the end of the token many bytes at a time when a scanner is available
+		if (scan != NULL && source->last_char != EOF)
+		{
+			const uint8_t *first = source->cursor - 1;
+			const uint8_t *limit = (source->end - first > MAX_SENTENCE_LENGTH) ? first + MAX_SENTENCE_LENGTH : source->end;
+			const uint8_t *q = scan(first, source->cursor, limit);
+
+			// Point token to source memory and continue after it
+			SkipTo(source, q);
+			tt->slice = start;
+			tt->length = q - start;
+			tt->materialized = false;
+			return;
+		}
+
+		// Walk identifier
+		length++;
+		NextChar(source);
+		while ((source->last_char != EOF) &&
+				((CharClass(source->last_char) & run) || (filter && filter(source->last_char, length, _T start + offset + length))) &&
+				(length < MAX_SENTENCE_LENGTH))
+		{
+			length++;
+			NextChar(source);
+		}
+
+		// Point token to source memory
+		tt->slice = start;
+		tt->length = offset + length;
+		tt->materialized = false;
+		return;
+	}
 
 	// Copy first char to str
-	*p++ = source->last_char;
+	if (offset + 1 >= tt->str_size)
+		TokenStrGrow(tt, offset + 1);
+	tt->str[offset + length++] = source->last_char;
 	NextChar(source);
 
 	// Copy identifier into str
-	while ((source->last_char != EOF) && filter(source->last_char, p - str, p) && ((p - str) < MAX_SENTENCE_LENGTH))
+	while ((source->last_char != EOF) &&
+			((CharClass(source->last_char) & run) || (filter && filter(source->last_char, length, tt->str + offset + length))) &&
+			(length < MAX_SENTENCE_LENGTH))
 	{
-		*p++ = source->last_char;
+		if (offset + length + 1 >= tt->str_size)
+			TokenStrGrow(tt, offset + length + 1);
+		tt->str[offset + length++] = source->last_char;
 		NextChar(source);
 	}
 
 	// End str
-	*p = 0;
+	tt->str[offset + length] = 0;
+	tt->slice = tt->str;
+	tt->length = offset + length;
+	tt->materialized = true;
 }
 
 static void ParseDefineLiteral(token_source_t *source, token_t *tt)
 {
 	// >>>>>>>>>>>>>>>>>>>>>>>>>    DEFINE
 	tt->type = CPARSER_TOKEN_TYPE_DEFINE_LITERAL;
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 
 	// Check if current char for define literal is different
 	if (source->last_char != '\r' && source->last_char != '\n')
 	{
 		// Digest define literal with Cpp comment filter (they behave exactly the same)
-		ParseDigestString(source, tt->str, ParseCppCommentAcceptanceFilter);
+		ParseDigestString(source, tt, 0, 0, ParseCppCommentAcceptanceFilter, ScanLine);
 	}
 	else
 	{
 		// No literal so assign empty string
 		tt->str[0] = 0;
+		tt->length = 0;
 	}
 }
 
@@ -159,21 +372,20 @@ static void ParseIncludeFilename(token_source_t *source, token_t *tt)
 {
 	// Include file name literal
 	tt->type = CPARSER_TOKEN_TYPE_INCLUDE_LITERAL;
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 
 	// Digest include literal with include acceptance filter
-	ParseDigestString(source, tt->str, ParseIncludeAcceptanceFilter);
+	ParseDigestString(source, tt, 0, 0, ParseIncludeAcceptanceFilter, NULL);
 }
 
 static void ParseSingleCharToken(token_source_t *source, token_t *tt)
 {
 	// >>>>>>>>>>>>>>>>>>>>>>>>>    Single char token
 	tt->type = CPARSER_TOKEN_TYPE_SINGLE_CHAR;
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 	tt->str[0] = source->last_char;
 	tt->str[1] = 0;
+	tt->length = 1;
 
 	// Prepare next char
 	NextChar(source);
@@ -183,44 +395,94 @@ static void ParseIdentifier(token_source_t *source, token_t *tt)
 {
 	// >>>>>>>>>>>>>>>>>>>>>>>>>    Identifier
 	tt->type = CPARSER_TOKEN_TYPE_IDENTIFIER;
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 
 	// Digest identifier with identifier acceptance filter
-	ParseDigestString(source, tt->str, ParseIdentifierAcceptanceFilter);
+	ParseDigestString(source, tt, 0, CHAR_CLASS_IDENTIFIER, NULL, ScanIdentifierRun);
+
+	// Tag keywords so the parser does not compare strings
+	tt->keyword = KeywordFind(tt->slice, tt->length);
 }
 
 static void ParseNumberLiteral(token_source_t *source, token_t *tt)
 {
 	// >>>>>>>>>>>>>>>>>>>>>>>    Number literal
 	tt->type = CPARSER_TOKEN_TYPE_NUMBER_LITERAL;
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 
 	// Digest number literal with number acceptance filter
-	ParseDigestString(source, tt->str, ParseNumberLiteralAcceptanceFilter);
+	ParseDigestString(source, tt, 0, CHAR_CLASS_NUMBER_LITERAL, NULL, NULL);
 }
 
 static void ParseStringLiteral(token_source_t *source, token_t *tt)
 {
 	// >>>>>>>>>>>>>>>>>>>>>>>>    String literal
 	tt->type = CPARSER_TOKEN_TYPE_STRING_LITERAL;
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 
 	// Digest string literal with string acceptance filter
-	ParseDigestString(source, tt->str, ParseStringLiteralAcceptanceFilter);
+	ParseDigestString(source, tt, 0, 0, ParseStringLiteralAcceptanceFilter, NULL);
 }
 
 static void ParseCharLiteral(token_source_t *source, token_t *tt)
 {
 	// >>>>>>>>>>>>>>>>>>>>>>>    Char literal
 	tt->type = CPARSER_TOKEN_TYPE_CHAR_LITERAL;
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 
 	// Digest char literal with char acceptance filter
-	ParseDigestString(source, tt->str, ParseCharLiteralAcceptanceFilter);
+	ParseDigestString(source, tt, 0, 0, ParseCharLiteralAcceptanceFilter, NULL);
+}
+
+static uint8_t ParseOperatorCode(uint8_t first, uint8_t second)
+{
+	// Operator of one or two chars, second is 0 for single char operators
+	switch (first)
+	{
+
+	case '+':
+		return (second == '+') ? CPARSER_OPERATOR_INCREMENT : (second == '=') ? CPARSER_OPERATOR_ADD_ASSIGN : CPARSER_OPERATOR_ADD;
+
+	case '-':
+		return (second == '-') ? CPARSER_OPERATOR_DECREMENT : (second == '=') ? CPARSER_OPERATOR_SUB_ASSIGN : CPARSER_OPERATOR_SUB;
+
+	case '*':
+		return (second == '=') ? CPARSER_OPERATOR_MUL_ASSIGN : CPARSER_OPERATOR_MUL;
+
+	case '/':
+		return (second == '=') ? CPARSER_OPERATOR_DIV_ASSIGN : CPARSER_OPERATOR_DIV;
+
+	case '%':
+		return (second == '=') ? CPARSER_OPERATOR_MOD_ASSIGN : CPARSER_OPERATOR_MOD;
+
+	case '=':
+		return (second == '=') ? CPARSER_OPERATOR_EQUAL : CPARSER_OPERATOR_ASSIGN;
+
+	case '!':
+		return (second == '=') ? CPARSER_OPERATOR_NOT_EQUAL : CPARSER_OPERATOR_LOGICAL_NOT;
+
+	case '<':
+		return (second == '<') ? CPARSER_OPERATOR_SHIFT_LEFT : (second == '=') ? CPARSER_OPERATOR_LESS_EQUAL : CPARSER_OPERATOR_LESS;
+
+	case '>':
+		return (second == '>') ? CPARSER_OPERATOR_SHIFT_RIGHT : (second == '=') ? CPARSER_OPERATOR_GREATER_EQUAL : CPARSER_OPERATOR_GREATER;
+
+	case '&':
+		return (second == '&') ? CPARSER_OPERATOR_LOGICAL_AND : (second == '=') ? CPARSER_OPERATOR_AND_ASSIGN : CPARSER_OPERATOR_BIT_AND;
+
+	case '|':
+		return (second == '|') ? CPARSER_OPERATOR_LOGICAL_OR : (second == '=') ? CPARSER_OPERATOR_OR_ASSIGN : CPARSER_OPERATOR_BIT_OR;
+
+	case '^':
+		return (second == '=') ? CPARSER_OPERATOR_XOR_ASSIGN : CPARSER_OPERATOR_BIT_XOR;
+
+	case '~':
+		return (second == 0) ? CPARSER_OPERATOR_BIT_NOT : CPARSER_OPERATOR_NONE;
+
+	default:
+		return CPARSER_OPERATOR_NONE;
+
+	}
 }
 
 static void ParseDualOperator(token_source_t *source, token_t *tt)
@@ -228,8 +490,7 @@ static void ParseDualOperator(token_source_t *source, token_t *tt)
 	// >>>>>>>>>>>>>>>>>>>>>>>    =, ==, +, ++, +=, -, --, -=, |, ||, |=, &, &&, &=, >, >=, >>
 	// Row and column correspond to operator
 	tt->type = CPARSER_TOKEN_TYPE_OPERATOR;
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 	tt->str[0] = source->last_char;
 
 	// Prepare next char
@@ -240,6 +501,7 @@ static void ParseDualOperator(token_source_t *source, token_t *tt)
 		// Dual operator
 		tt->str[1] = source->last_char;
 		tt->str[2] = 0;
+		tt->length = 2;
 
 		// Prepare next char
 		NextChar(source);
@@ -248,7 +510,11 @@ static void ParseDualOperator(token_source_t *source, token_t *tt)
 	{
 		// Single operator
 		tt->str[1] = 0;
+		tt->length = 1;
 	}
+
+	// Classify operator so evaluators do not compare strings
+	tt->op = ParseOperatorCode(tt->str[0], tt->str[1]);
 }
 
 static void ParseSingleOperator(token_source_t *source, token_t *tt)
@@ -256,8 +522,7 @@ static void ParseSingleOperator(token_source_t *source, token_t *tt)
 	// >>>>>>>>>>>>>>>>>>>>>>>    *, *=, %, %=, ^, ^=, !, !=, ~, ~=
 	// Row and column correspond to symbol
 	tt->type = CPARSER_TOKEN_TYPE_OPERATOR;
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 	tt->str[0] = source->last_char;
 
 	// Prepare next char
@@ -268,6 +533,7 @@ static void ParseSingleOperator(token_source_t *source, token_t *tt)
 		// Dual operator
 		tt->str[1] = source->last_char;
 		tt->str[2] = 0;
+		tt->length = 2;
 
 		// Prepare next char
 		NextChar(source);
@@ -276,15 +542,18 @@ static void ParseSingleOperator(token_source_t *source, token_t *tt)
 	{
 		// Single operator
 		tt->str[1] = 0;
+		tt->length = 1;
 	}
+
+	// Classify operator so evaluators do not compare strings
+	tt->op = ParseOperatorCode(tt->str[0], tt->str[1]);
 }
 
 static void ParseSlash(token_source_t *source, token_t *tt)
 {
 	// >>>>>>>>>>>>>>>>>>>>>>    /, /=, /*, //
 	// Row and column correspond to symbol
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 	tt->str[0] = source->last_char;
 
 	// Prepare next char
@@ -296,6 +565,8 @@ static void ParseSlash(token_source_t *source, token_t *tt)
 		tt->type = CPARSER_TOKEN_TYPE_OPERATOR;
 		tt->str[1] = source->last_char;
 		tt->str[2] = 0;
+		tt->length = 2;
+		tt->op = CPARSER_OPERATOR_DIV_ASSIGN;
 
 		// Prepare next char
 		NextChar(source);
@@ -306,7 +577,7 @@ static void ParseSlash(token_source_t *source, token_t *tt)
 		tt->type = CPARSER_TOKEN_TYPE_C_COMMENT;
 
 		// Append comment string to str
-		ParseDigestString(source, tt->str + 1, ParseCCommentAcceptanceFilter);
+		ParseDigestString(source, tt, 1, 0, ParseCCommentAcceptanceFilter, ScanCComment);
 	}
 	else if (source->last_char == '/')
 	{
@@ -314,13 +585,15 @@ static void ParseSlash(token_source_t *source, token_t *tt)
 		tt->type = CPARSER_TOKEN_TYPE_CPP_COMMENT;
 
 		// Append comment string to str
-		ParseDigestString(source, tt->str + 1, ParseCppCommentAcceptanceFilter);
+		ParseDigestString(source, tt, 1, 0, ParseCppCommentAcceptanceFilter, ScanLine);
 	}
 	else
 	{
 		// Single operator
 		tt->type = CPARSER_TOKEN_TYPE_OPERATOR;
 		tt->str[1] = 0;
+		tt->length = 1;
+		tt->op = CPARSER_OPERATOR_DIV;
 	}
 }
 
@@ -328,21 +601,141 @@ static void ParseBackSlash(token_source_t *source, token_t *tt)
 {
 	// Include file name literal
 	tt->type = CPARSER_TOKEN_TYPE_BACKSLASH;
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 
 	// Digest include literal with include acceptance filter
-	ParseDigestString(source, tt->str, ParseBackSlashAcceptanceFilter);
+	ParseDigestString(source, tt, 0, 0, ParseBackSlashAcceptanceFilter, NULL);
+}
+
+static void SkipInactiveCComment(token_source_t *source)
+{
+	uint16_t previous = 0;
+
+	// Current char is the star after the slash, in memory buffers jump straight after the terminator
+	if (SourceIsMemory(source))
+	{
+		const uint8_t *q = ScanCCommentEnd(source->cursor, source->end);
+		SkipTo(source, (q < source->end) ? q + 2 : q);
+		return;
+	}
+
+	// Walk comment up to its terminator
+	NextChar(source);
+	while ((source->last_char != EOF) && !(previous == '*' && source->last_char == '/'))
+	{
+		previous = source->last_char;
+		NextChar(source);
+	}
+	NextChar(source);
+}
+
+static void SkipInactiveCppComment(token_source_t *source)
+{
+	uint16_t previous[2] = { 0, 0 };
+
+	// Current char is the second slash, in memory buffers jump straight to the line end
+	if (SourceIsMemory(source))
+	{
+		SkipTo(source, ScanLine(source->cursor - 1, source->cursor, source->end));
+		return;
+	}
+
+	// Walk comment up to a new line not escaped with a backslash
+	do
+	{
+		previous[1] = previous[0];
+		previous[0] = source->last_char;
+		NextChar(source);
+	}
+	while ((source->last_char != EOF) &&
+			((source->last_char != '\n') || (previous[0] == '\\') || (previous[0] == '\r' && previous[1] == '\\')));
+}
+
+static void SkipInactiveLiteral(token_source_t *source)
+{
+	uint16_t quote = source->last_char;
+
+	// Walk literal up to closing quote, unterminated literals end with the line
+	NextChar(source);
+	while ((source->last_char != EOF) && (source->last_char != '\n') && (source->last_char != quote))
+	{
+		// Escaped chars, including new lines, belong to the literal
+		if (source->last_char == '\\')
+			NextChar(source);
+		if (source->last_char != EOF)
+			NextChar(source);
+	}
+
+	// Consume closing quote
+	if (source->last_char == quote)
+		NextChar(source);
+}
+
+/**
+ * Skips the lines of an inactive conditional compilation region
+ *
+ * Only a # at the beginning of a line is looked for. Comments and literals are walked over so
+ * that a # inside them is not taken for a directive.
+ *
+ * \param[in/out] 	source:	Token source whose current char is left at the # of the next directive, or EOF
+ */
+static void SkipInactiveLines(token_source_t *source)
+{
+	while (source->last_char != EOF)
+	{
+		if (source->last_char == '\n')
+		{
+			// Skip blanks at the beginning of the line and stop at directives
+			do
+				NextChar(source);
+			while ((source->last_char != '\n') && (CharClass(source->last_char) & CHAR_CLASS_EMPTY));
+
+			if (source->last_char == '#')
+				return;
+		}
+		else if (source->last_char == '/')
+		{
+			// Comments may hide new lines and directives
+			NextChar(source);
+			if (source->last_char == '*')
+				SkipInactiveCComment(source);
+			else if (source->last_char == '/')
+				SkipInactiveCppComment(source);
+		}
+		else if ((source->last_char == '\"') || (source->last_char == '\''))
+		{
+			// Literals may hide comments
+			SkipInactiveLiteral(source);
+		}
+		else if (source->last_char == '\\')
+		{
+			// Escaped new lines continue the current line
+			NextChar(source);
+			if (source->last_char == '\r')
+				NextChar(source);
+			if (source->last_char == '\n')
+				NextChar(source);
+		}
+		else if (SourceIsMemory(source))
+		{
+			// Jump to the next char that may change the state of the line
+			SkipTo(source, ScanInactive(source->cursor, source->end));
+		}
+		else
+		{
+			NextChar(source);
+		}
+	}
 }
 
 static void ParseInvalidCharacter(token_source_t *source, token_t *tt)
 {
 	// >>>>>>>>>>>>>>>>>>>>>>>>>    Invalid character
 	tt->type = CPARSER_TOKEN_TYPE_INVALID;
-	tt->row = source->row;
-	tt->column = source->column;
+	TokenSetPosition(tt, source);
 	tt->str[0] = source->last_char;
 	tt->str[1] = 0;
+	tt->length = 1;
 }
 
 void TokenSourceInit(token_source_t *source, void *from, read_callback_t read)
@@ -352,25 +745,143 @@ void TokenSourceInit(token_source_t *source, void *from, read_callback_t read)
 	source->row = 1;
 	source->column = 0;
 	source->read = read;
+	source->read_block = NULL;
+	source->cursor = NULL;
+	source->end = NULL;
+	source->base = NULL;
+	source->base_offset = 0;
+	source->started = false;
+	source->lazy_positions = false;
+	source->window = NULL;
 }
 
-token_t *TokenNew(void)
+void TokenSourceInitMemory(token_source_t *source, const uint8_t *data, size_t size)
 {
-	token_t *tt = malloc(sizeof(token_t));
+	source->from = NULL;
+	source->last_char = 0;
+	source->row = 1;
+	source->column = 0;
+	source->read = NULL;
+	source->read_block = NULL;
+	source->cursor = data;
+	source->end = data + size;
+	source->base = data;
+	source->base_offset = 0;
+	source->started = false;
+	source->lazy_positions = false;
+	source->window = NULL;
+}
+
+void TokenSourceInitBlock(token_source_t *source, void *from, read_block_callback_t read_block)
+{
+	source->from = from;
+	source->last_char = 0;
+	source->row = 1;
+	source->column = 0;
+	source->read = NULL;
+	source->read_block = read_block;
+	source->window = malloc(CPARSER_TOKEN_SOURCE_WINDOW_SIZE);
+	source->cursor = source->window;
+	source->end = source->window;
+	source->base = source->window;
+	source->base_offset = 0;
+	source->started = false;
+	source->lazy_positions = false;
+}
+
+void TokenSourceRelease(token_source_t *source)
+{
+	// Only block sources own a window
+	free(source->window);
+	source->window = NULL;
+}
+
+void TokenSourceSeek(token_source_t *source, size_t offset)
+{
+	// Only memory buffers can be repositioned, the char at offset becomes the current one
+	// Rows and columns are not updated, so positions shall be lazy
+	source->cursor = source->base + offset;
+	source->started = true;
+	NextChar(source);
+}
+
+void TokenSourceSetLazyPositions(token_source_t *source, bool lazy)
+{
+	source->lazy_positions = lazy;
+}
 
+/**
+ * Initializes a token owned by the caller, for example in the stack
+ *
+ * \param[out]	tt:	Token to initialize, release it with TokenRelease
+ */
+void TokenInit(token_t *tt)
+{
 	tt->type = CPARSER_TOKEN_TYPE_INVALID;
 	tt->first_token_in_line = true;
 	tt->row = 0;
 	tt->column = 0;
-	tt->str = malloc(MAX_SENTENCE_LENGTH + 10);
+	tt->offset = 0;
+	tt->length = 0;
+	tt->materialized = true;
+	tt->keyword = CPARSER_KEYWORD_NONE;
+	tt->op = CPARSER_OPERATOR_NONE;
+	tt->atom = ATOM_NONE;
+
+	// Reuse a string buffer released in this thread, or create a small one that grows on demand
+	if (str_pool.count > 0)
+	{
+		str_pool.count--;
+		tt->str = str_pool.str[str_pool.count];
+		tt->str_size = str_pool.str_size[str_pool.count];
+	}
+	else
+	{
+		tt->str = malloc(CPARSER_TOKEN_STR_INITIAL_SIZE);
+		tt->str_size = CPARSER_TOKEN_STR_INITIAL_SIZE;
+	}
+	tt->slice = tt->str;
+}
+
+void TokenRelease(token_t *tt)
+{
+	// Return string buffer to the pool if there is room, otherwise delete it
+	if (str_pool.count < CPARSER_TOKEN_STR_POOL_SIZE)
+	{
+		str_pool.str[str_pool.count] = tt->str;
+		str_pool.str_size[str_pool.count] = tt->str_size;
+		str_pool.count++;
+	}
+	else
+	{
+		free(tt->str);
+	}
+}
+
+/**
+ * Frees the string buffers pooled by the calling thread
+ *
+ * Threads other than the parser one shall call it before they exit, their pool is lost otherwise.
+ */
+void TokenPoolDrain(void)
+{
+	while (str_pool.count > 0)
+		free(str_pool.str[--str_pool.count]);
+}
+
+token_t *TokenNew(void)
+{
+	token_t *tt = malloc(sizeof(token_t));
+
+	TokenInit(tt);
 
 	return tt;
 }
 
 void TokenDelete(token_t *tt)
 {
-	// Delete string buffer in token and token itself
-	free(tt->str);
+	// Release string buffer and delete token itself
+	TokenRelease(tt);
 	free(tt);
 }
 
@@ -378,10 +889,18 @@ bool TokenNext(token_t *tt, token_source_t *source, uint32_t flags)
 {
 	bool res = true;
 
+	// Short tokens are written straight into str, digested ones may point to source memory
+	tt->slice = tt->str;
+	tt->materialized = true;
+	tt->keyword = CPARSER_KEYWORD_NONE;
+	tt->op = CPARSER_OPERATOR_NONE;
+	tt->atom = ATOM_NONE;
+
 	// In the beginning source next char
-	if (source->row == 1 && source->column == 0)
+	if (!source->started)
 	{
 		tt->first_token_in_line = true;			// In the beginning first token in line shall be true
+		source->started = true;
 		NextChar(source);
 	}
 	else
@@ -390,6 +909,13 @@ bool TokenNext(token_t *tt, token_source_t *source, uint32_t flags)
 		tt->first_token_in_line = false;
 	}
 
+	// Skip inactive conditional compilation lines up to the next directive
+	if (flags & CPARSER_TOKEN_FLAG_SKIP_INACTIVE_LINES)
+	{
+		SkipInactiveLines(source);
+		tt->first_token_in_line = true;
+	}
+
 	// Skip empty chars if define literal (they can be empty)
 	if (flags & CPARSER_TOKEN_FLAG_PARSE_PREPROCESSOR_LITERAL)
 	{
@@ -401,8 +927,15 @@ bool TokenNext(token_t *tt, token_source_t *source, uint32_t flags)
 	}
 	else
 	{
-		// Skip spaces, tabs, new lines and returns
-		while (CharInSet(source->last_char, set_empty_chars))
+		// Skip spaces, tabs, new lines and returns, many at a time in memory buffers
+		if (SourceIsMemory(source) && (CharClass(source->last_char) & CHAR_CLASS_EMPTY))
+		{
+			const uint8_t *q = ScanEmpty(source->cursor, source->end);
+
+			tt->first_token_in_line |= ScanNewline(source->cursor - 1, q) < q;
+			SkipTo(source, q);
+		}
+		while (CharClass(source->last_char) & CHAR_CLASS_EMPTY)
 		{
 			tt->first_token_in_line |= source->last_char == '\n';
 			NextChar(source);
@@ -429,60 +962,75 @@ bool TokenNext(token_t *tt, token_source_t *source, uint32_t flags)
 		if (source->last_char == '(')
 		{
 			// Add macro function parameters to definition identifier
-			ParseDigestString(source, tt->str + strlen(_t tt->str), ParseDefineFunctionParamsAcceptanceFilter);
+			ParseDigestString(source, tt, tt->length, 0, ParseDefineFunctionParamsAcceptanceFilter, NULL);
+			tt->keyword = CPARSER_KEYWORD_NONE;
 		}
 	}
-	else if (CharInSet(source->last_char, set_single_char_token_chars))
-	{
-		// Single char token
-		ParseSingleCharToken(source, tt);
-	}
-	else if (CharInSet(source->last_char, set_lead_identifier_chars))
-	{
-		// Identifier token
-		ParseIdentifier(source, tt);
-	}
-	else if (CharInSet(source->last_char, set_lead_number_literal_chars))
-	{
-		// Number literal token
-		ParseNumberLiteral(source, tt);
-	}
-	else if (source->last_char == '\"')
-	{
-		// String literal token
-		ParseStringLiteral(source, tt);
-	}
-	else if (source->last_char == '\'')
-	{
-		// Character literal token
-		ParseCharLiteral(source, tt);
-	}
-	else if (CharInSet(source->last_char, set_dual_operator_chars))
-	{
-		// Dual operator token
-		ParseDualOperator(source, tt);
-	}
-	else if (CharInSet(source->last_char, set_single_operator_chars))
-	{
-		// Single operator token
-		ParseSingleOperator(source, tt);
-	}
-	else if (source->last_char == '/')
-	{
-		// Slash token
-		ParseSlash(source, tt);
-	}
-	else if (source->last_char == '\\')
-	{
-		// Backslash token
-		ParseBackSlash(source, tt);
-	}
 	else
 	{
-		// Invalid character
-		ParseInvalidCharacter(source, tt);
-		res = false;
+		// Run the lexer state selected by the first char of the token
+		switch (lexer_start_state[(uint8_t)source->last_char])
+		{
+
+		case LEXER_STATE_SINGLE_CHAR:
+			ParseSingleCharToken(source, tt);
+			break;
+
+		case LEXER_STATE_IDENTIFIER:
+			ParseIdentifier(source, tt);
+			break;
+
+		case LEXER_STATE_NUMBER_LITERAL:
+			ParseNumberLiteral(source, tt);
+			break;
+
+		case LEXER_STATE_STRING_LITERAL:
+			ParseStringLiteral(source, tt);
+			break;
+
+		case LEXER_STATE_CHAR_LITERAL:
+			ParseCharLiteral(source, tt);
+			break;
+
+		case LEXER_STATE_DUAL_OPERATOR:
+			ParseDualOperator(source, tt);
+			break;
+
+		case LEXER_STATE_SINGLE_OPERATOR:
+			ParseSingleOperator(source, tt);
+			break;
+
+		case LEXER_STATE_SLASH:
+			ParseSlash(source, tt);
+			break;
+
+		case LEXER_STATE_BACKSLASH:
+			ParseBackSlash(source, tt);
+			break;
+
+		default:
+			// Invalid character
+			ParseInvalidCharacter(source, tt);
+			res = false;
+			break;
+
+		}
 	}
 
 	return res;
 }
+
+const uint8_t *TokenMaterialize(token_t *tt)
+{
+	// Copy token bytes from source memory into str
+	if (!tt->materialized)
+	{
+		if (tt->length + 1 > tt->str_size)
+			TokenStrGrow(tt, tt->length);
+		memcpy(tt->str, tt->slice, tt->length);
+		tt->str[tt->length] = 0;
+		tt->materialized = true;
+	}
+
+	return tt->str;
+}
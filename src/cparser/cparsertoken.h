@@ -12,6 +12,11 @@
 #define CPARSER_TOKEN_FLAG_PARSE_INCLUDE_FILENAME		1
 #define CPARSER_TOKEN_FLAG_PARSE_PREPROCESSOR_LITERAL			2
 #define CPARSER_TOKEN_FLAG_PARSE_DEFINE_IDENTIFIER		4
+#define CPARSER_TOKEN_FLAG_SKIP_INACTIVE_LINES			8
+
+#define CPARSER_TOKEN_SOURCE_WINDOW_SIZE				4096
+#define CPARSER_TOKEN_STR_INITIAL_SIZE					256
+#define CPARSER_TOKEN_STR_POOL_SIZE						16
 
 
 // Token type
@@ -31,14 +36,60 @@ typedef enum token_type_e
 	CPARSER_TOKEN_TYPE_INVALID
 } token_type_t;
 
+// Operator of operator tokens
+typedef enum token_operator_e
+{
+	CPARSER_OPERATOR_NONE = 0,
+	CPARSER_OPERATOR_ADD,					// +
+	CPARSER_OPERATOR_INCREMENT,				// ++
+	CPARSER_OPERATOR_ADD_ASSIGN,			// +=
+	CPARSER_OPERATOR_SUB,					// -
+	CPARSER_OPERATOR_DECREMENT,				// --
+	CPARSER_OPERATOR_SUB_ASSIGN,			// -=
+	CPARSER_OPERATOR_MUL,					// *
+	CPARSER_OPERATOR_MUL_ASSIGN,			// *=
+	CPARSER_OPERATOR_DIV,					// /
+	CPARSER_OPERATOR_DIV_ASSIGN,			// /=
+	CPARSER_OPERATOR_MOD,					// %
+	CPARSER_OPERATOR_MOD_ASSIGN,			// %=
+	CPARSER_OPERATOR_ASSIGN,				// =
+	CPARSER_OPERATOR_EQUAL,					// ==
+	CPARSER_OPERATOR_NOT_EQUAL,				// !=
+	CPARSER_OPERATOR_LESS,					// <
+	CPARSER_OPERATOR_LESS_EQUAL,			// <=
+	CPARSER_OPERATOR_GREATER,				// >
+	CPARSER_OPERATOR_GREATER_EQUAL,			// >=
+	CPARSER_OPERATOR_SHIFT_LEFT,			// <<
+	CPARSER_OPERATOR_SHIFT_RIGHT,			// >>
+	CPARSER_OPERATOR_BIT_AND,				// &
+	CPARSER_OPERATOR_AND_ASSIGN,			// &=
+	CPARSER_OPERATOR_BIT_OR,				// |
+	CPARSER_OPERATOR_OR_ASSIGN,				// |=
+	CPARSER_OPERATOR_BIT_XOR,				// ^
+	CPARSER_OPERATOR_XOR_ASSIGN,			// ^=
+	CPARSER_OPERATOR_BIT_NOT,				// ~
+	CPARSER_OPERATOR_LOGICAL_AND,			// &&
+	CPARSER_OPERATOR_LOGICAL_OR,			// ||
+	CPARSER_OPERATOR_LOGICAL_NOT,			// !
+	CPARSER_OPERATOR_COUNT
+} token_operator_t;
+
 // Parse token
 typedef struct token_s
 {
 	token_type_t type;
 	bool first_token_in_line;
-	uint32_t row;
-	uint32_t column;
+	uint32_t row;				// Row, not tracked when the source computes positions lazily
+	uint32_t column;			// Column, not tracked when the source computes positions lazily
+	uint32_t offset;			// Byte offset of the token in the input
 	uint8_t *str;
+	uint32_t str_size;			// Size of str buffer, it grows on demand
+	const uint8_t *slice;		// Token bytes, in source memory buffer or in str when materialized
+	uint32_t length;			// Token bytes count
+	bool materialized;			// True when token bytes are copied into str and null terminated
+	uint8_t keyword;			// CPARSER_KEYWORD_XXX of identifiers, CPARSER_KEYWORD_NONE for the rest of tokens
+	uint8_t op;					// CPARSER_OPERATOR_XXX of operators, CPARSER_OPERATOR_NONE for the rest of tokens
+	uint32_t atom;				// Interned identifier, ATOM_NONE if not interned
 } token_t;
 
 // Source read callback function
@@ -46,6 +97,13 @@ typedef struct token_s
 // parameters: from: data source for this callback function
 typedef int (*read_callback_t)(void *from);
 
+// Source read block callback function
+// returns: number of bytes copied to buf, 0 if no more bytes available
+// parameters: from: data source for this callback function
+//             buf: buffer to fill with the bytes read
+//             cap: buf capacity
+typedef size_t (*read_block_callback_t)(void *from, uint8_t *buf, size_t cap);
+
 // Token source
 typedef struct token_source_s
 {
@@ -53,15 +111,32 @@ typedef struct token_source_s
 	int16_t last_char;			// Last char read
 	uint32_t row;				// Row
 	uint32_t column;			// Column
-	read_callback_t read;		// Callback to read data source
+	read_callback_t read;		// Callback to read data source, NULL when reading from a memory buffer
+	read_block_callback_t read_block;	// Callback to refill window, NULL when reading from a memory buffer
+	const uint8_t *cursor;		// Next byte to read in memory buffer or window
+	const uint8_t *end;			// End of memory buffer or window
+	const uint8_t *base;		// Start of memory buffer or window
+	size_t base_offset;			// Input offset of base, or count of bytes read with "read" callback
+	bool started;				// True once the first char is read
+	bool lazy_positions;		// True to skip row and column tracking, tokens carry only their offset
+	uint8_t *window;			// Window filled by read_block callback, only allocated for block sources
 } token_source_t;
 
 
 void TokenSourceInit(token_source_t *source, void *from, read_callback_t read);
+void TokenSourceInitMemory(token_source_t *source, const uint8_t *data, size_t size);
+void TokenSourceInitBlock(token_source_t *source, void *from, read_block_callback_t read_block);
+void TokenSourceRelease(token_source_t *source);
+void TokenSourceSetLazyPositions(token_source_t *source, bool lazy);
+void TokenSourceSeek(token_source_t *source, size_t offset);
 
+void TokenInit(token_t *tt);
+void TokenRelease(token_t *tt);
 token_t *TokenNew(void);
 void TokenDelete(token_t *tt);
+void TokenPoolDrain(void);
 bool TokenNext(token_t *tt, token_source_t *source, uint32_t flags);
+const uint8_t *TokenMaterialize(token_t *tt);
 
 
 #endif /* CPARSERTOKEN_H_ */
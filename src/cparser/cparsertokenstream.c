@@ -0,0 +1,724 @@
+/*
+ * cparsertokenstream.c
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "cparserscan.h"
+#include "cparsertoken.h"
+#include "cparserkeyword.h"
+#include "cparseratom.h"
+#include "cparsertokenstream.h"
+
+
+#define TOKEN_STREAM_MIN_SIZE		64
+
+
+// Tokens of a file kept as parallel arrays
+struct cparsertokenstream_s
+{
+	const uint8_t *data;	// File contents the tokens point to
+	size_t data_size;		// File contents size
+	uint8_t *kind;			// Token type of each token
+	uint32_t *offset;		// Byte offset of each token
+	uint32_t *length;		// Byte count of each token
+	uint8_t *flags;			// CPARSER_TOKEN_STREAM_FLAG_XXX of each token
+	uint8_t *keyword;		// CPARSER_KEYWORD_XXX of each token
+	uint8_t *op;			// CPARSER_OPERATOR_XXX of each token
+	atom_t *atom;			// Atom of each identifier token, ATOM_NONE otherwise. NULL until the whole file is lexed
+	uint32_t count;			// Number of tokens
+	uint32_t size;			// Capacity of the arrays
+	atom_t guard;			// Include guard macro of the file, ATOM_NONE if none
+};
+
+// Chunk of a big file lexed in its own thread
+typedef struct token_stream_chunk_s
+{
+	const uint8_t *data;				// File contents
+	size_t data_size;					// File contents size
+	size_t start;						// Offset of the chunk, right after a new line
+	size_t end;							// Offset after the chunk, right after a new line
+	cparsertokenstream_t outside;		// Tokens lexed supposing the chunk starts out of a C comment
+	cparsertokenstream_t inside;		// Tokens lexed supposing the chunk starts inside a C comment, after its end
+	size_t comment_end;					// Offset after the first C comment terminator of the chunk, end if none
+	uint32_t join;						// First outside token that follows the inside ones
+	bool outside_stopped;				// Outside lexing stopped at an invalid char
+	bool inside_stopped;				// Inside lexing stopped at an invalid char
+	pthread_t thread;					// Thread lexing the chunk
+	bool threaded;						// True if thread was created
+} token_stream_chunk_t;
+
+
+static void TokenStreamResize(cparsertokenstream_t *ts, uint32_t size)
+{
+	// Resize all the arrays at once
+	ts->size = (size < TOKEN_STREAM_MIN_SIZE) ? TOKEN_STREAM_MIN_SIZE : size;
+	ts->kind = realloc(ts->kind, sizeof(uint8_t) * ts->size);
+	ts->offset = realloc(ts->offset, sizeof(uint32_t) * ts->size);
+	ts->length = realloc(ts->length, sizeof(uint32_t) * ts->size);
+	ts->flags = realloc(ts->flags, sizeof(uint8_t) * ts->size);
+	ts->keyword = realloc(ts->keyword, sizeof(uint8_t) * ts->size);
+	ts->op = realloc(ts->op, sizeof(uint8_t) * ts->size);
+}
+
+static void TokenStreamInit(cparsertokenstream_t *ts, const uint8_t *data, size_t size)
+{
+	ts->data = data;
+	ts->data_size = size;
+	ts->kind = NULL;
+	ts->offset = NULL;
+	ts->length = NULL;
+	ts->flags = NULL;
+	ts->keyword = NULL;
+	ts->op = NULL;
+	ts->atom = NULL;
+	ts->count = 0;
+	ts->size = 0;
+	ts->guard = ATOM_NONE;
+}
+
+static void TokenStreamRelease(cparsertokenstream_t *ts)
+{
+	free(ts->kind);
+	free(ts->offset);
+	free(ts->length);
+	free(ts->flags);
+	free(ts->keyword);
+	free(ts->op);
+	free(ts->atom);
+}
+
+static void TokenStreamAppend(cparsertokenstream_t *ts, uint8_t kind, uint32_t offset, uint32_t length, uint8_t flags, uint8_t keyword, uint8_t op)
+{
+	if (ts->count == ts->size)
+		TokenStreamResize(ts, ts->size * 2);
+
+	ts->kind[ts->count] = kind;
+	ts->offset[ts->count] = offset;
+	ts->length[ts->count] = length;
+	ts->flags[ts->count] = flags;
+	ts->keyword[ts->count] = keyword;
+	ts->op[ts->count] = op;
+	ts->count++;
+}
+
+static void TokenStreamAppendRange(cparsertokenstream_t *ts, const cparsertokenstream_t *from, uint32_t first, uint32_t last)
+{
+	uint32_t count = last - first;
+
+	// Make room for all the tokens at once
+	if (ts->count + count > ts->size)
+		TokenStreamResize(ts, ts->count + count);
+
+	memcpy(ts->kind + ts->count, from->kind + first, sizeof(uint8_t) * count);
+	memcpy(ts->offset + ts->count, from->offset + first, sizeof(uint32_t) * count);
+	memcpy(ts->length + ts->count, from->length + first, sizeof(uint32_t) * count);
+	memcpy(ts->flags + ts->count, from->flags + first, sizeof(uint8_t) * count);
+	memcpy(ts->keyword + ts->count, from->keyword + first, sizeof(uint8_t) * count);
+	memcpy(ts->op + ts->count, from->op + first, sizeof(uint8_t) * count);
+	ts->count += count;
+}
+
+static uint32_t TokenStreamFind(const cparsertokenstream_t *ts, uint32_t offset)
+{
+	uint32_t lo = 0;
+	uint32_t hi = ts->count;
+
+	// Binary search the first token at or after offset
+	while (lo < hi)
+	{
+		uint32_t mid = lo + (hi - lo) / 2;
+
+		if (ts->offset[mid] < offset)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/**
+ * Lexes a range of the file appending its tokens to a stream
+ *
+ * \param[in/out] 	ts:			Stream that receives the tokens, its data is the whole file
+ * \param[in]		start:		Offset where lexing starts, out of any token
+ * \param[in]		end:		Offset where lexing ends
+ * \param[in]		align:		Tokens already lexed from an earlier start in the same range, NULL if none
+ * \param[out]		stopped:	true if lexing stopped at an invalid char before end
+ *
+ * \return When align is given, lexing stops after the first token that starts at the same offset as an align
+ * token, and the index of the align token after it is returned. Otherwise, or if no token matches, returns 0.
+ */
+static uint32_t TokenStreamLex(cparsertokenstream_t *ts, size_t start, size_t end, const cparsertokenstream_t *align, bool *stopped)
+{
+	token_source_t source;
+	token_t *tt = TokenNew();
+	uint32_t first = ts->count;
+	uint32_t res = 0;
+
+	// Lex the range, stopping like the parser at the first invalid token
+	TokenSourceInitMemory(&source, ts->data + start, end - start);
+	TokenSourceSetLazyPositions(&source, true);
+	while (TokenNext(tt, &source, 0))
+	{
+		uint32_t offset = start + tt->offset;
+
+		TokenStreamAppend(ts, tt->type, offset, tt->length, tt->first_token_in_line ? CPARSER_TOKEN_STREAM_FLAG_FIRST_IN_LINE : 0, tt->keyword, tt->op);
+
+		// From a token that starts like an align token on, both lexings give the same tokens
+		if (align != NULL)
+		{
+			uint32_t i = TokenStreamFind(align, offset);
+
+			if (i < align->count && align->offset[i] == offset)
+			{
+				res = i + 1;
+				break;
+			}
+		}
+	}
+	*stopped = (res == 0) && (source.last_char != EOF);
+
+	// The first token only starts a line if a new line is skipped before it
+	if ((ts->count > first) && (start > 0) && (ts->data[start - 1] != '\n'))
+	{
+		const uint8_t *p = ts->data + ts->offset[first];
+
+		if (ScanNewline(ts->data + start, p) == p)
+			ts->flags[first] &= ~CPARSER_TOKEN_STREAM_FLAG_FIRST_IN_LINE;
+	}
+
+	TokenDelete(tt);
+
+	return res;
+}
+
+static void *TokenStreamLexChunk(void *arg)
+{
+	token_stream_chunk_t *cc = arg;
+	const uint8_t *q;
+
+	// Lex chunk supposing it starts out of any C comment
+	TokenStreamInit(&cc->outside, cc->data, cc->data_size);
+	TokenStreamResize(&cc->outside, (cc->end - cc->start) / 8);
+	TokenStreamLex(&cc->outside, cc->start, cc->end, NULL, &cc->outside_stopped);
+
+	// Lex chunk supposing it starts inside a C comment, until tokens match the ones lexed from outside
+	TokenStreamInit(&cc->inside, cc->data, cc->data_size);
+	TokenStreamResize(&cc->inside, 0);
+	q = ScanCCommentEnd(cc->data + cc->start, cc->data + cc->end);
+	cc->comment_end = (q < cc->data + cc->end) ? (size_t)(q + 2 - cc->data) : cc->end;
+	cc->join = TokenStreamLex(&cc->inside, cc->comment_end, cc->end, &cc->outside, &cc->inside_stopped);
+	if (cc->join == 0)
+		cc->join = cc->outside.count;
+	else
+		cc->inside_stopped = cc->outside_stopped;
+
+	return NULL;
+}
+
+static void *TokenStreamLexChunkThread(void *arg)
+{
+	TokenStreamLexChunk(arg);
+
+	// Token buffers pooled by the thread would be lost when it exits
+	TokenPoolDrain();
+
+	return NULL;
+}
+
+static uint32_t TokenStreamGetThreadCount(size_t size)
+{
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t count = size / CPARSER_TOKEN_STREAM_CHUNK_MIN_SIZE;
+
+	if (cpus < 1)
+		cpus = 1;
+	if (count > (size_t)cpus)
+		count = cpus;
+	if (count > CPARSER_TOKEN_STREAM_THREADS_MAX)
+		count = CPARSER_TOKEN_STREAM_THREADS_MAX;
+
+	return (count < 1) ? 1 : count;
+}
+
+/**
+ * Lexes a big file in chunks on several threads
+ *
+ * Chunks are split at new lines and each one is lexed twice: supposing it starts out of a C comment, and
+ * supposing it starts inside one. Chunks are stitched afterwards taking the lexing that matches the state
+ * the previous chunk ends in. A token other than a C comment cut by a chunk end is not predicted, so the
+ * rest of the file is lexed sequentially from it.
+ *
+ * \param[in/out] 	ts:			Empty stream that receives the tokens
+ * \param[in]		threads:	Number of chunks and threads
+ */
+static void TokenStreamLexParallel(cparsertokenstream_t *ts, uint32_t threads)
+{
+	token_stream_chunk_t chunks[CPARSER_TOKEN_STREAM_THREADS_MAX];
+	bool in_comment = false;
+	bool stopped = false;
+	uint32_t count = 0;
+	size_t start = 0;
+
+	// Split file in chunks that end right after a new line
+	for (uint32_t i = 0; i < threads && start < ts->data_size; i++)
+	{
+		const uint8_t *end = ts->data + ts->data_size;
+		const uint8_t *q = ts->data + ts->data_size * (i + 1) / threads;
+
+		// Every chunk but the last ends after the first new line from its share of the file on
+		if (i + 1 < threads)
+		{
+			if (q <= ts->data + start)
+				q = ts->data + start + 1;
+			q = ScanNewline(q - 1, end);
+			if (q < end)
+				q++;
+		}
+
+		chunks[count].data = ts->data;
+		chunks[count].data_size = ts->data_size;
+		chunks[count].start = start;
+		chunks[count].end = q - ts->data;
+		start = chunks[count].end;
+		count++;
+	}
+
+	// Lex chunks, the first one in the calling thread, and the rest in the calling thread too if no thread is available
+	for (uint32_t i = 1; i < count; i++)
+		chunks[i].threaded = pthread_create(&chunks[i].thread, NULL, TokenStreamLexChunkThread, &chunks[i]) == 0;
+	for (uint32_t i = 0; i < count; i++)
+		if (i == 0 || !chunks[i].threaded)
+			TokenStreamLexChunk(&chunks[i]);
+	for (uint32_t i = 1; i < count; i++)
+		if (chunks[i].threaded)
+			pthread_join(chunks[i].thread, NULL);
+
+	// Stitch chunks
+	for (uint32_t i = 0; i < count && !stopped; i++)
+	{
+		token_stream_chunk_t *cc = &chunks[i];
+
+		if (!in_comment)
+		{
+			// Chunk starts out of a comment
+			TokenStreamAppendRange(ts, &cc->outside, 0, cc->outside.count);
+			stopped = cc->outside_stopped;
+		}
+		else
+		{
+			// Comment from previous chunk goes on up to the first terminator
+			ts->length[ts->count - 1] = cc->comment_end - ts->offset[ts->count - 1];
+			TokenStreamAppendRange(ts, &cc->inside, 0, cc->inside.count);
+			TokenStreamAppendRange(ts, &cc->outside, cc->join, cc->outside.count);
+			stopped = cc->inside_stopped;
+		}
+
+		// Check if the last token is cut by the chunk end
+		in_comment = false;
+		if (!stopped && (i + 1 < count) && (ts->count > 0) && (ts->offset[ts->count - 1] + ts->length[ts->count - 1] == cc->end))
+		{
+			if (ts->kind[ts->count - 1] == CPARSER_TOKEN_TYPE_C_COMMENT)
+			{
+				// Next chunk starts inside the comment
+				in_comment = true;
+			}
+			else
+			{
+				uint8_t flags = ts->flags[ts->count - 1];
+				uint32_t first;
+
+				// Lex again from the cut token up to the end of the file
+				ts->count--;
+				first = ts->count;
+				TokenStreamLex(ts, ts->offset[first], ts->data_size, NULL, &stopped);
+				if (ts->count > first)
+					ts->flags[first] = flags;
+				stopped = true;
+			}
+		}
+	}
+
+	// Release chunks
+	for (uint32_t i = 0; i < count; i++)
+	{
+		TokenStreamRelease(&chunks[i].outside);
+		TokenStreamRelease(&chunks[i].inside);
+	}
+}
+
+static uint32_t TokenStreamGuardNextToken(const cparsertokenstream_t *ts, uint32_t i)
+{
+	uint32_t count = ts->count;
+
+	// Skip comments and line continuations, they do not count as file contents
+	while (i < count)
+	{
+		token_type_t kind = ts->kind[i];
+
+		if ((kind != CPARSER_TOKEN_TYPE_C_COMMENT) && (kind != CPARSER_TOKEN_TYPE_CPP_COMMENT) && (kind != CPARSER_TOKEN_TYPE_BACKSLASH))
+			break;
+		i++;
+	}
+
+	return i;
+}
+
+static keyword_t TokenStreamGuardDirective(const cparsertokenstream_t *ts, uint32_t *i)
+{
+	uint32_t j = *i;
+
+	// Directive starts with a '#' first in its line followed by its keyword
+	if ((j >= ts->count) ||
+		(ts->kind[j] != CPARSER_TOKEN_TYPE_SINGLE_CHAR) ||
+		(ts->data[ts->offset[j]] != '#') ||
+		!(ts->flags[j] & CPARSER_TOKEN_STREAM_FLAG_FIRST_IN_LINE))
+		return CPARSER_KEYWORD_NONE;
+
+	// Keyword shall be in the same line, a lone '#' is a null directive
+	j = TokenStreamGuardNextToken(ts, j + 1);
+	if ((j >= ts->count) || (ts->flags[j] & CPARSER_TOKEN_STREAM_FLAG_FIRST_IN_LINE))
+		return CPARSER_KEYWORD_NONE;
+
+	*i = TokenStreamGuardNextToken(ts, j + 1);
+	return ts->keyword[j];
+}
+
+static atom_t TokenStreamGuardIdentifier(const cparsertokenstream_t *ts, uint32_t *i)
+{
+	uint32_t j = *i;
+
+	if ((j >= ts->count) || (ts->kind[j] != CPARSER_TOKEN_TYPE_IDENTIFIER))
+		return ATOM_NONE;
+
+	*i = TokenStreamGuardNextToken(ts, j + 1);
+	return ts->atom[j];
+}
+
+static bool TokenStreamGuardPunctuator(const cparsertokenstream_t *ts, uint32_t *i, uint8_t c)
+{
+	uint32_t j = *i;
+
+	// Single character token in the same line, '!' is read as an operator
+	if ((j >= ts->count) || (ts->length[j] != 1) ||
+		(ts->flags[j] & CPARSER_TOKEN_STREAM_FLAG_FIRST_IN_LINE) ||
+		(ts->data[ts->offset[j]] != c))
+		return false;
+
+	*i = TokenStreamGuardNextToken(ts, j + 1);
+	return true;
+}
+
+static atom_t TokenStreamGuardCondition(const cparsertokenstream_t *ts, uint32_t *i)
+{
+	keyword_t keyword = TokenStreamGuardDirective(ts, i);
+	bool parenthesis;
+	atom_t guard;
+
+	if (keyword == CPARSER_KEYWORD_IFNDEF)
+		return TokenStreamGuardIdentifier(ts, i);
+	if (keyword != CPARSER_KEYWORD_IF)
+		return ATOM_NONE;
+
+	// #if !defined X or #if !defined(X), nothing else in the condition
+	if (!TokenStreamGuardPunctuator(ts, i, '!') || (*i >= ts->count) ||
+		(ts->flags[*i] & CPARSER_TOKEN_STREAM_FLAG_FIRST_IN_LINE) ||
+		(ts->keyword[*i] != CPARSER_KEYWORD_DEFINED))
+		return ATOM_NONE;
+	*i = TokenStreamGuardNextToken(ts, *i + 1);
+	parenthesis = TokenStreamGuardPunctuator(ts, i, '(');
+	if ((*i >= ts->count) || (ts->flags[*i] & CPARSER_TOKEN_STREAM_FLAG_FIRST_IN_LINE))
+		return ATOM_NONE;
+	if ((guard = TokenStreamGuardIdentifier(ts, i)) == ATOM_NONE)
+		return ATOM_NONE;
+	if (parenthesis && !TokenStreamGuardPunctuator(ts, i, ')'))
+		return ATOM_NONE;
+	if ((*i < ts->count) && !(ts->flags[*i] & CPARSER_TOKEN_STREAM_FLAG_FIRST_IN_LINE))
+		return ATOM_NONE;
+
+	return guard;
+}
+
+/**
+ * Detects the include guard of a file
+ *
+ * A file is guarded when, comments apart, it is a single #ifndef X or
+ * #if !defined(X) block without #else or #elif whose first directive is
+ * #define X.
+ *
+ * \param[in]	ts:		file token stream, with its atoms
+ *
+ * \return guard macro, ATOM_NONE if the file is not guarded
+ */
+static atom_t TokenStreamDetectIncludeGuard(const cparsertokenstream_t *ts)
+{
+	uint32_t count = ts->count;
+	uint32_t i = TokenStreamGuardNextToken(ts, 0);
+	uint32_t depth = 1;
+	atom_t guard;
+
+	// #ifndef X or #if !defined(X) followed by #define X
+	if ((guard = TokenStreamGuardCondition(ts, &i)) == ATOM_NONE)
+		return ATOM_NONE;
+	if ((TokenStreamGuardDirective(ts, &i) != CPARSER_KEYWORD_DEFINE) || (TokenStreamGuardIdentifier(ts, &i) != guard))
+		return ATOM_NONE;
+
+	// Track nesting until the #endif closing the guard
+	while ((i < count) && (depth > 0))
+	{
+		uint32_t start = i;
+
+		switch (TokenStreamGuardDirective(ts, &i))
+		{
+		case CPARSER_KEYWORD_IF:
+		case CPARSER_KEYWORD_IFDEF:
+		case CPARSER_KEYWORD_IFNDEF:
+			depth++;
+			break;
+
+		case CPARSER_KEYWORD_ELSE:
+		case CPARSER_KEYWORD_ELIF:
+			// Contents outside the guard
+			if (depth == 1)
+				return ATOM_NONE;
+			break;
+
+		case CPARSER_KEYWORD_ENDIF:
+			depth--;
+			break;
+
+		default:
+			// Other directives are skipped up to their keyword, the rest of tokens one by one
+			if (i == start)
+				i = TokenStreamGuardNextToken(ts, i + 1);
+			break;
+		}
+	}
+
+	// Nothing but comments may follow the closing #endif
+	return ((depth == 0) && (i >= count)) ? guard : ATOM_NONE;
+}
+
+cparsertokenstream_t *TokenStreamNew(const uint8_t *data, size_t size)
+{
+	cparsertokenstream_t *ts = malloc(sizeof(cparsertokenstream_t));
+	uint32_t threads = TokenStreamGetThreadCount(size);
+	bool stopped;
+
+	TokenStreamInit(ts, data, size);
+
+	// Reserve room for a token every few bytes to avoid most of the growths
+	TokenStreamResize(ts, size / 8);
+
+	// Lex the whole file, big files in parallel
+	if (threads > 1)
+		TokenStreamLexParallel(ts, threads);
+	else
+		TokenStreamLex(ts, 0, size, NULL, &stopped);
+
+	// Intern identifiers once, in the calling thread since atoms are not shared between threads
+	ts->atom = malloc(sizeof(atom_t) * (ts->count ? ts->count : 1));
+	for (uint32_t i = 0; i < ts->count; i++)
+		ts->atom[i] = (ts->kind[i] == CPARSER_TOKEN_TYPE_IDENTIFIER) ? AtomIntern(data + ts->offset[i], ts->length[i]) : ATOM_NONE;
+
+	// Include guard stays with the tokens, later includes of unchanged contents skip the file without parsing it
+	ts->guard = TokenStreamDetectIncludeGuard(ts);
+
+	return ts;
+}
+
+void TokenStreamDelete(cparsertokenstream_t *ts)
+{
+	if (!ts)
+		return;
+
+	TokenStreamRelease(ts);
+	free(ts);
+}
+
+uint32_t TokenStreamGetCount(const cparsertokenstream_t *ts)
+{
+	return ts->count;
+}
+
+token_type_t TokenStreamGetKind(const cparsertokenstream_t *ts, uint32_t index)
+{
+	return ts->kind[index];
+}
+
+uint32_t TokenStreamGetOffset(const cparsertokenstream_t *ts, uint32_t index)
+{
+	return ts->offset[index];
+}
+
+uint32_t TokenStreamGetLength(const cparsertokenstream_t *ts, uint32_t index)
+{
+	return ts->length[index];
+}
+
+uint8_t TokenStreamGetFlags(const cparsertokenstream_t *ts, uint32_t index)
+{
+	return ts->flags[index];
+}
+
+keyword_t TokenStreamGetKeyword(const cparsertokenstream_t *ts, uint32_t index)
+{
+	return ts->keyword[index];
+}
+
+atom_t TokenStreamGetAtom(const cparsertokenstream_t *ts, uint32_t index)
+{
+	return ts->atom[index];
+}
+
+atom_t TokenStreamGetGuard(const cparsertokenstream_t *ts)
+{
+	return ts->guard;
+}
+
+void TokenStreamReaderInit(token_stream_reader_t *reader, const cparsertokenstream_t *ts)
+{
+	reader->stream = ts;
+	reader->position = 0;
+	reader->end = 0;
+	reader->direct = false;
+	reader->resynced = false;
+	TokenSourceInitMemory(&reader->source, ts->data, ts->data_size);
+	TokenSourceSetLazyPositions(&reader->source, true);
+}
+
+/**
+ * Skips the stream tokens of an inactive conditional compilation region
+ *
+ * Like SkipInactiveLines, it stops at the next # that begins a line. Literals spanning lines and backslashes
+ * are lexed differently when lines are skipped, so the stream is not followed past them.
+ *
+ * \param[in/out] 	reader:	Token stream reader, its position is left at the # of the next directive
+ *
+ * \return true if the next directive is found in the stream, false if the lines shall be skipped lexing them
+ */
+static bool TokenStreamReaderSkipInactive(token_stream_reader_t *reader)
+{
+	const cparsertokenstream_t *ts = reader->stream;
+
+	for (uint32_t i = reader->position; i < ts->count; i++)
+	{
+		const uint8_t *p = ts->data + ts->offset[i];
+		bool first_in_line = (ts->flags[i] & CPARSER_TOKEN_STREAM_FLAG_FIRST_IN_LINE) != 0;
+
+		// After lexed tokens only the bytes skipped from them count for the first token in line
+		if ((i == reader->position) && reader->resynced)
+			first_in_line = ScanNewline(ts->data + reader->end, p) < p;
+
+		if ((ts->kind[i] == CPARSER_TOKEN_TYPE_SINGLE_CHAR) && (*p == '#') && first_in_line)
+		{
+			reader->position = i;
+			return true;
+		}
+
+		if ((ts->kind[i] == CPARSER_TOKEN_TYPE_BACKSLASH) ||
+				(((ts->kind[i] == CPARSER_TOKEN_TYPE_STRING_LITERAL) || (ts->kind[i] == CPARSER_TOKEN_TYPE_CHAR_LITERAL)) &&
+				(ScanNewline(p, p + ts->length[i]) < p + ts->length[i])))
+		{
+			return false;
+		}
+	}
+
+	// No directive up to the end of the stream, lexing tells whether the stream stopped at an invalid char
+	return false;
+}
+
+/**
+ * Gets next token from a token stream
+ *
+ * Tokens are taken from the stream while the parser requests them with no flags, or skipping inactive lines
+ * when the stream can be followed up to the next directive. Tokens requested with other flags are lexed again
+ * from the source, and the reader goes back to the stream as soon as the lexed tokens end at a stream token
+ * boundary.
+ *
+ * \param[in/out] 	reader:	Token stream reader
+ * \param[out]		tt:		token filled, its bytes point to the file contents
+ * \param[in]		flags:	CPARSER_TOKEN_FLAG_XXX, same as TokenNext
+ *
+ * \return true if a token is returned, false at the end of the tokens like TokenNext
+ */
+bool TokenStreamReaderNext(token_stream_reader_t *reader, token_t *tt, uint32_t flags)
+{
+	const cparsertokenstream_t *ts = reader->stream;
+	uint32_t i = reader->position;
+	bool res;
+
+	// Inactive lines are skipped over the stream tokens up to the next directive
+	if ((flags == CPARSER_TOKEN_FLAG_SKIP_INACTIVE_LINES) && !reader->direct && TokenStreamReaderSkipInactive(reader))
+	{
+		i = reader->position;
+		flags = 0;
+	}
+
+	if (flags == 0 && !reader->direct)
+	{
+		// End of stream
+		if (i >= ts->count)
+		{
+			tt->type = CPARSER_TOKEN_TYPE_INVALID;
+			tt->length = 0;
+			return false;
+		}
+
+		// Fill token from stream
+		tt->type = ts->kind[i];
+		tt->offset = ts->offset[i];
+		tt->length = ts->length[i];
+		tt->slice = ts->data + ts->offset[i];
+		tt->materialized = false;
+		tt->keyword = ts->keyword[i];
+		tt->op = ts->op[i];
+		tt->atom = ts->atom[i];
+		tt->first_token_in_line = (ts->flags[i] & CPARSER_TOKEN_STREAM_FLAG_FIRST_IN_LINE) != 0;
+
+		// After lexed tokens only the bytes skipped from them count for the first token in line
+		if (reader->resynced)
+		{
+			tt->first_token_in_line = ScanNewline(ts->data + reader->end, tt->slice) < tt->slice;
+			reader->resynced = false;
+		}
+
+		reader->end = tt->offset + tt->length;
+		reader->position++;
+
+		return true;
+	}
+
+	// Lex from the end of the last token
+	if (!reader->direct)
+	{
+		TokenSourceSeek(&reader->source, reader->end);
+		reader->direct = true;
+	}
+	res = TokenNext(tt, &reader->source, flags);
+	reader->end = tt->offset + tt->length;
+	if (tt->type == CPARSER_TOKEN_TYPE_IDENTIFIER)
+		tt->atom = AtomIntern(tt->slice, tt->length);
+
+	// Back to the stream if no stream token is cut by the end of the lexed token
+	i = TokenStreamFind(ts, reader->end);
+	if (res && i < ts->count && (i == 0 || ts->offset[i - 1] + ts->length[i - 1] <= reader->end))
+	{
+		reader->position = i;
+		reader->direct = false;
+		reader->resynced = true;
+	}
+
+	return res;
+}
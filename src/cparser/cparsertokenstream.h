@@ -0,0 +1,48 @@
+/*
+ * cparsertokenstream.h
+ *
+ *  Created on: 18/10/2026
+ *      Author: blue
+ */
+
+#ifndef CPARSER_CPARSERTOKENSTREAM_H_
+#define CPARSER_CPARSERTOKENSTREAM_H_
+
+
+#define CPARSER_TOKEN_STREAM_FLAG_FIRST_IN_LINE		1
+
+#define CPARSER_TOKEN_STREAM_CHUNK_MIN_SIZE			(1 << 20)	// 1 Mb
+#define CPARSER_TOKEN_STREAM_THREADS_MAX			16
+
+
+struct cparsertokenstream_s;
+typedef struct cparsertokenstream_s cparsertokenstream_t;
+
+// Token stream reader
+typedef struct token_stream_reader_s
+{
+	const cparsertokenstream_t *stream;	// Stream read
+	uint32_t position;			// Next stream token to return
+	uint32_t end;				// Input offset right after the last token returned
+	bool direct;				// True while tokens are lexed from source because they differ from the stream
+	bool resynced;				// True when the next stream token follows a lexed one
+	token_source_t source;		// Source to lex tokens that the parser requests with flags
+} token_stream_reader_t;
+
+
+cparsertokenstream_t *TokenStreamNew(const uint8_t *data, size_t size);
+void TokenStreamDelete(cparsertokenstream_t *ts);
+uint32_t TokenStreamGetCount(const cparsertokenstream_t *ts);
+token_type_t TokenStreamGetKind(const cparsertokenstream_t *ts, uint32_t index);
+uint32_t TokenStreamGetOffset(const cparsertokenstream_t *ts, uint32_t index);
+uint32_t TokenStreamGetLength(const cparsertokenstream_t *ts, uint32_t index);
+uint8_t TokenStreamGetFlags(const cparsertokenstream_t *ts, uint32_t index);
+keyword_t TokenStreamGetKeyword(const cparsertokenstream_t *ts, uint32_t index);
+atom_t TokenStreamGetAtom(const cparsertokenstream_t *ts, uint32_t index);
+atom_t TokenStreamGetGuard(const cparsertokenstream_t *ts);
+
+void TokenStreamReaderInit(token_stream_reader_t *reader, const cparsertokenstream_t *ts);
+bool TokenStreamReaderNext(token_stream_reader_t *reader, token_t *tt, uint32_t flags);
+
+
+#endif /* CPARSER_CPARSERTOKENSTREAM_H_ */
@@ -0,0 +1,165 @@
+/*
+ * cparserdictionary_test.c
+ *
+ *  Dictionary snapshot regression tests
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "cparsertools.h"
+#include "cparseratom.h"
+#include "cparserdictionary.h"
+
+
+#define KEYS_COUNT			300
+#define COLLISIONS_COUNT	3
+
+// Keys whose 32 bit hashes are equal, they are kept in trie nodes past the deepest hash fragment
+static const char *collisions[COLLISIONS_COUNT] = { "K2395384", "K4465098", "K5839843" };
+
+static atom_t keys[KEYS_COUNT + COLLISIONS_COUNT];
+static int values[KEYS_COUNT + COLLISIONS_COUNT][2];
+static uint32_t failures = 0;
+
+
+// Expected contents of a dictionary, NULL for keys not in it
+typedef struct expected_s
+{
+	const char *name;
+	const void *values[KEYS_COUNT + COLLISIONS_COUNT];
+} expected_t;
+
+
+static void Set(cparserdictionary_t *d, expected_t *e, uint32_t i, const void *value)
+{
+	DictionarySetAtomValue(d, keys[i], value);
+	e->values[i] = value;
+}
+
+static void Remove(cparserdictionary_t *d, expected_t *e, uint32_t i)
+{
+	DictionaryRemoveAtom(d, keys[i]);
+	e->values[i] = NULL;
+}
+
+static void ExpectContents(cparserdictionary_t *d, const expected_t *e)
+{
+	bool listed[KEYS_COUNT + COLLISIONS_COUNT] = { false };
+	uint32_t count = 0;
+
+	// Lookups
+	for (uint32_t i = 0; i < KEYS_COUNT + COLLISIONS_COUNT; i++)
+	{
+		if (DictionaryGetAtomValue(d, keys[i]) != e->values[i] || DictionaryExistsAtom(d, keys[i]) != (e->values[i] != NULL))
+		{
+			printf("%s: key %s has an unexpected value\n", e->name, AtomGetString(keys[i]));
+			failures++;
+		}
+		count += (e->values[i] != NULL);
+	}
+
+	if (DictionaryGetKeyCount(d) != count)
+	{
+		printf("%s: expected %u keys, got %u\n", e->name, count, DictionaryGetKeyCount(d));
+		failures++;
+		return;
+	}
+
+	// Index listing holds each key once with its value
+	for (uint32_t ix = 0; ix < count; ix++)
+	{
+		const uint8_t *key = DictionaryGetKeyByIndex(d, ix);
+		atom_t atom = (key != NULL) ? AtomFind(key, strlen(_t key)) : ATOM_NONE;
+		uint32_t i;
+
+		for (i = 0; i < KEYS_COUNT + COLLISIONS_COUNT && keys[i] != atom; i++)
+			;
+		if (i == KEYS_COUNT + COLLISIONS_COUNT || listed[i] || e->values[i] == NULL || DictionaryGetValueByIndex(d, ix) != e->values[i])
+		{
+			printf("%s: index %u lists an unexpected key\n", e->name, ix);
+			failures++;
+			return;
+		}
+		listed[i] = true;
+	}
+}
+
+static void TestSnapshot(void)
+{
+	cparserdictionary_t *d = DictionaryNew();
+	cparserdictionary_t *s;
+	expected_t ed = { "dictionary", { NULL } };
+	expected_t es;
+
+	for (uint32_t i = 0; i < KEYS_COUNT + COLLISIONS_COUNT; i++)
+		Set(d, &ed, i, &values[i][0]);
+	ExpectContents(d, &ed);
+
+	// Snapshot starts equal
+	s = DictionarySnapshot(d);
+	es = ed;
+	es.name = "snapshot";
+	ExpectContents(s, &es);
+
+	// Changes on each side are not seen from the other one
+	for (uint32_t i = 0; i < KEYS_COUNT; i += 3)
+		Remove(d, &ed, i);
+	for (uint32_t i = 1; i < KEYS_COUNT; i += 3)
+		Set(d, &ed, i, &values[i][1]);
+	for (uint32_t i = 2; i < KEYS_COUNT; i += 5)
+		Remove(s, &es, i);
+	for (uint32_t i = 0; i < KEYS_COUNT; i += 4)
+		Set(s, &es, i, &values[i][1]);
+
+	// Keys with equal hashes
+	Remove(d, &ed, KEYS_COUNT + 1);
+	Set(s, &es, KEYS_COUNT, &values[KEYS_COUNT][1]);
+	Remove(s, &es, KEYS_COUNT + 2);
+	ExpectContents(d, &ed);
+	ExpectContents(s, &es);
+
+	// Removing keys not there changes nothing
+	DictionaryRemoveAtom(d, keys[0]);
+	DictionaryRemoveAtom(d, AtomIntern(_T "MISSING", 7));
+	ExpectContents(d, &ed);
+
+	// Emptied collision nodes are dropped, and keys can be added again
+	Remove(d, &ed, KEYS_COUNT);
+	Remove(d, &ed, KEYS_COUNT + 2);
+	ExpectContents(d, &ed);
+	Set(d, &ed, KEYS_COUNT + 1, &values[KEYS_COUNT + 1][1]);
+	ExpectContents(d, &ed);
+	ExpectContents(s, &es);
+
+	// Deleting one side leaves the other one intact
+	DictionaryDelete(d);
+	for (uint32_t i = 0; i < KEYS_COUNT + COLLISIONS_COUNT; i += 2)
+		Remove(s, &es, i);
+	ExpectContents(s, &es);
+	DictionaryDelete(s);
+}
+
+int main()
+{
+	char name[16];
+
+	for (uint32_t i = 0; i < KEYS_COUNT; i++)
+	{
+		sprintf(name, "KEY%u", i);
+		keys[i] = AtomIntern(_T name, strlen(name));
+	}
+	for (uint32_t i = 0; i < COLLISIONS_COUNT; i++)
+		keys[KEYS_COUNT + i] = AtomIntern(_T collisions[i], strlen(collisions[i]));
+
+	if ((AtomGetHash(keys[KEYS_COUNT]) != AtomGetHash(keys[KEYS_COUNT + 1])) || (AtomGetHash(keys[KEYS_COUNT]) != AtomGetHash(keys[KEYS_COUNT + 2])))
+	{
+		printf("collision keys do not share their hash\n");
+		failures++;
+	}
+
+	TestSnapshot();
+
+	return (failures == 0) ? 0 : 1;
+}
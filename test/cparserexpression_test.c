@@ -0,0 +1,179 @@
+/*
+ * cparserexpression_test.c
+ *
+ *  Preprocessor expression evaluator regression tests
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "cparsertools.h"
+#include "cparserpaths.h"
+#include "cparsertoken.h"
+#include "cparserlines.h"
+#include "cparseratom.h"
+#include "cparserfile.h"
+#include "cparserobject.h"
+#include "cparserdictionary.h"
+#include "cparserexpression.h"
+#include "cparser.h"
+
+
+static const char defines_text[] =
+	"#define A 21\n"
+	"#define B (A * 2)\n"
+	"#define C (B + 1)\n"
+	"#define R (R + 1)\n"
+	"#define U 1U\n";
+
+static cparserexpression_cache_t *cache;
+static cparserdictionary_t *defines;
+static uint32_t failures = 0;
+
+
+static void ExpectValue(const char *expression, intmax_t value)
+{
+	cparserexpression_result_t r;
+
+	ExpressionEvalPreprocessor(cache, defines, _T expression, 1, 1, &r);
+	if ((r.code != EXPRESSION_RESULT_SUCCESS) || (r.value != value))
+	{
+		printf("'%s': expected %jd, got %jd with code %d\n", expression, value, r.value, r.code);
+		failures++;
+	}
+}
+
+static void ExpectError(const char *expression, cparserexpression_result_code_t code)
+{
+	cparserexpression_result_t r;
+
+	ExpressionEvalPreprocessor(cache, defines, _T expression, 1, 1, &r);
+	if (r.code != code)
+	{
+		printf("'%s': expected code %d, got %d\n", expression, code, r.code);
+		failures++;
+	}
+}
+
+static void TestArithmetic(void)
+{
+	ExpectValue("1 + 2 * 3", 7);
+	ExpectValue("(1 + 2) * 3", 9);
+	ExpectValue("10 - 3 - 2", 5);
+	ExpectValue("100 / 10 / 5", 2);
+	ExpectValue("-7 / 2", -3);
+	ExpectValue("-7 % 2", -1);
+	ExpectValue("~0", -1);
+	ExpectValue("!5", 0);
+	ExpectValue("-1 < 0", 1);
+	ExpectValue("-1 < 0U", 0);
+	ExpectValue("0x10 | 010 | 0b1", 25);
+}
+
+static void TestDivision(void)
+{
+	ExpectError("1 / 0", EXPRESSION_RESULT_ERROR_DIVISION_BY_ZERO);
+	ExpectError("1 % 0", EXPRESSION_RESULT_ERROR_DIVISION_BY_ZERO);
+	ExpectError("1U / 0", EXPRESSION_RESULT_ERROR_DIVISION_BY_ZERO);
+	ExpectError("(-9223372036854775807 - 1) / -1", EXPRESSION_RESULT_ERROR_OVERFLOW);
+	ExpectValue("(-9223372036854775807 - 1) % -1", 0);
+	ExpectValue("(-9223372036854775807 - 1) / -1U", 0);
+}
+
+static void TestShift(void)
+{
+	ExpectValue("1 << 3", 8);
+	ExpectValue("1 << 63", INTMAX_MIN);
+	ExpectValue("1 << 64", 0);
+	ExpectValue("1 << 1000", 0);
+	ExpectValue("1 << 0xFFFFFFFFFFFFFFFFU", 0);
+	ExpectValue("-8 >> 1", -4);
+	ExpectValue("-1 >> 64", -1);
+	ExpectValue("1 >> 64", 0);
+	ExpectValue("1 >> -1", 2);
+	ExpectValue("4 << -1", 2);
+	ExpectValue("0xFFFFFFFFFFFFFFFF >> 63", 1);
+}
+
+static void TestLogical(void)
+{
+	ExpectValue("2 && 3", 1);
+	ExpectValue("0 || 5", 1);
+	ExpectValue("0 && 1", 0);
+	ExpectValue("0 || 0", 0);
+	ExpectValue("1 || 1 / 0", 1);
+	ExpectValue("0 && 1 / 0", 0);
+	ExpectValue("0 && 1 / 0 || 1", 1);
+	ExpectValue("1 || 0 && 1 / 0", 1);
+	ExpectValue("(0 && 1 / 0) + 2", 2);
+	ExpectError("1 && 1 / 0", EXPRESSION_RESULT_ERROR_DIVISION_BY_ZERO);
+	ExpectError("0 || 1 % 0", EXPRESSION_RESULT_ERROR_DIVISION_BY_ZERO);
+}
+
+static void TestDefinitions(void)
+{
+	ExpectValue("A", 21);
+	ExpectValue("C", 43);
+	ExpectValue("UNDEFINED", 0);
+	ExpectValue("defined(A) && !defined UNDEFINED", 1);
+	ExpectValue("R", 1);
+	ExpectValue("U - 2 > 0", 1);
+}
+
+static void TestRedefinition(void)
+{
+	object_t *a = ObjectNewPreprocessorExpression(_T "1");
+	const object_t *c = DictionaryGetAtomValue(defines, AtomIntern(_T "C", 1));
+
+	// Cached values follow the definitions they depend on
+	ExpectValue("C", 43);
+	DictionarySetAtomValue(defines, AtomIntern(_T "A", 1), a);
+	ExpectValue("C", 3);
+	DictionarySetAtomValue(defines, AtomIntern(_T "Z", 1), a);
+	ExpectValue("C", 3);
+	DictionaryRemoveAtom(defines, AtomIntern(_T "A", 1));
+	ExpectValue("C", 1);
+	if (c->value_generation == OBJECT_VALUE_NONE)
+	{
+		printf("C value not cached\n");
+		failures++;
+	}
+
+	DictionaryRemoveAtom(defines, AtomIntern(_T "Z", 1));
+	ObjectDelete(a);
+}
+
+static void TestErrors(void)
+{
+	char deep[512];
+
+	ExpectError("", EXPRESSION_RESULT_ERROR_LAST_EXPRESSION_TOKEN_SHALL_BE_A_DECODED_VALUE);
+	ExpectError("1 +", EXPRESSION_RESULT_ERROR_OPERATOR_WITH_NO_OPERANDS);
+	ExpectError("(1", EXPRESSION_RESULT_ERROR_INCORRECT_PARENTHESIS);
+	ExpectError("1 2", EXPRESSION_RESULT_ERROR_OPERAND_BESIDES_OPERAND);
+	ExpectError("1.5", EXPRESSION_RESULT_ERROR_INVALID_NUMBER_LITERAL);
+
+	memset(deep, '(', 300);
+	strcpy(deep + 300, "1");
+	ExpectError(deep, EXPRESSION_RESULT_ERROR_EXPRESSION_TOO_DEEP);
+}
+
+int main()
+{
+	defines = CParserLoadDefines(_T defines_text, sizeof(defines_text) - 1);
+	cache = ExpressionCacheNew();
+
+	TestArithmetic();
+	TestDivision();
+	TestShift();
+	TestLogical();
+	TestDefinitions();
+	TestRedefinition();
+	TestErrors();
+
+	ExpressionCacheDelete(cache);
+	DictionaryDelete(defines);
+
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+/*
+ * cparserguard_test.c
+ *
+ *  Include guard skipping regression tests
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "cparsertools.h"
+#include "cparserpaths.h"
+#include "cparsertoken.h"
+#include "cparserlines.h"
+#include "cparseratom.h"
+#include "cparserfile.h"
+#include "cparserobject.h"
+#include "cparserdictionary.h"
+#include "cparser.h"
+
+
+static uint32_t failures = 0;
+
+
+static void CountIncludes(const object_t *o, const char *filename, uint32_t *parsed, uint32_t *skipped)
+{
+	if ((o->data != NULL) && (strcmp((const char *)o->data, filename) == 0))
+	{
+		if (o->type == OBJECT_TYPE_HEADER_FILE)
+			(*parsed)++;
+		else if (o->type == OBJECT_TYPE_INCLUDE_SKIPPED)
+			(*skipped)++;
+	}
+
+	for (uint32_t i = 0; i < o->children_count; i++)
+		CountIncludes(o->children[i], filename, parsed, skipped);
+}
+
+static void ExpectIncludes(const object_t *root, const char *filename, uint32_t parsed, uint32_t skipped)
+{
+	uint32_t p = 0;
+	uint32_t s = 0;
+
+	CountIncludes(root, filename, &p, &s);
+	if ((p != parsed) || (s != skipped))
+	{
+		printf("%s: expected %u parsed and %u skipped, got %u and %u\n", filename, parsed, skipped, p, s);
+		failures++;
+	}
+}
+
+int main()
+{
+	cparserpaths_t *paths = PathsNew();
+	cparserdictionary_t *defines = DictionaryNew();
+	cparser_t *parser;
+	object_t *root;
+
+	PathsAddPath(paths, _T "data");
+	parser = CParserNew(defines, paths);
+	root = CParserParse(parser, _T "data/guard.c");
+	CParserDelete(parser);
+
+	if (root == NULL)
+	{
+		printf("data/guard.c: not parsed\n");
+		failures++;
+	}
+	else
+	{
+		// Second inclusion of a guarded header is skipped
+		ExpectIncludes(root, "guard_ifndef.h", 1, 1);
+		ExpectIncludes(root, "guard_if_defined.h", 1, 1);
+		ExpectIncludes(root, "guard_if_defined_bare.h", 1, 1);
+
+		// Headers whose contents are not all inside the guard are parsed again
+		ExpectIncludes(root, "guard_condition.h", 2, 0);
+		ExpectIncludes(root, "guard_else.h", 2, 0);
+		ObjectDelete(root);
+	}
+
+	DictionaryDelete(defines);
+	PathsDelete(paths);
+
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+/*
+ * cparserliteral_test.c
+ *
+ *  Integer literal decoder regression tests
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "cparserliteral.h"
+
+
+static uint32_t failures = 0;
+
+
+static void ExpectValue(const char *literal, uintmax_t value, bool is_unsigned)
+{
+	literal_integer_t li;
+
+	if (!LiteralDecodeInteger((const uint8_t *)literal, strlen(literal), &li) || (li.value != value) || (li.is_unsigned != is_unsigned))
+	{
+		printf("'%s': expected %ju%s, got %ju%s\n", literal, value, is_unsigned ? "U" : "", li.value, li.is_unsigned ? "U" : "");
+		failures++;
+	}
+}
+
+static void ExpectInvalid(const char *literal)
+{
+	literal_integer_t li;
+
+	if (LiteralDecodeInteger((const uint8_t *)literal, strlen(literal), &li))
+	{
+		printf("'%s': expected invalid, got %ju\n", literal, li.value);
+		failures++;
+	}
+}
+
+static void TestDecimal(void)
+{
+	ExpectValue("0", 0, false);
+	ExpectValue("7", 7, false);
+	ExpectValue("1234567", 1234567, false);
+	ExpectValue("12345678", 12345678, false);
+	ExpectValue("123456789012345678", 123456789012345678u, false);
+	ExpectValue("9223372036854775807", INTMAX_MAX, false);
+	ExpectValue("9223372036854775808", (uintmax_t)INTMAX_MAX + 1, true);
+	ExpectValue("18446744073709551615", UINTMAX_MAX, true);
+	ExpectInvalid("18446744073709551616");
+	ExpectInvalid("99999999999999999999999");
+}
+
+static void TestRadix(void)
+{
+	ExpectValue("0x0", 0, false);
+	ExpectValue("0x1F", 31, false);
+	ExpectValue("0XaBcDeF", 0xABCDEF, false);
+	ExpectValue("0xFFFFFFFFFFFFFFFF", UINTMAX_MAX, true);
+	ExpectValue("017", 15, false);
+	ExpectValue("0777", 511, false);
+	ExpectValue("0b101", 5, false);
+	ExpectValue("0B1111111111111111111111111111111111111111111111111111111111111111", UINTMAX_MAX, true);
+	ExpectInvalid("0x");
+	ExpectInvalid("0b");
+	ExpectInvalid("0x1FFFFFFFFFFFFFFFF");
+	ExpectInvalid("08");
+	ExpectInvalid("0b2");
+	ExpectInvalid("0xG");
+}
+
+static void TestSuffix(void)
+{
+	ExpectValue("1U", 1, true);
+	ExpectValue("1u", 1, true);
+	ExpectValue("1L", 1, false);
+	ExpectValue("1LL", 1, false);
+	ExpectValue("1ull", 1, true);
+	ExpectValue("1LLU", 1, true);
+	ExpectValue("0x10UL", 16, true);
+	ExpectInvalid("1UU");
+	ExpectInvalid("1LLL");
+	ExpectInvalid("1lL");
+	ExpectInvalid("1.0");
+	ExpectInvalid("1e3");
+	ExpectInvalid("12a");
+	ExpectInvalid("a");
+	ExpectInvalid("");
+}
+
+int main()
+{
+	TestDecimal();
+	TestRadix();
+	TestSuffix();
+
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/*
+ * cparserpaths_test.c
+ *
+ *  Search paths index and resolution cache tests
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "cparsertools.h"
+#include "cparserpaths.h"
+
+
+static char root[] = "/tmp/cparserpaths_XXXXXX";
+static uint32_t failures = 0;
+
+
+static const char *Path(const char *name)
+{
+	static char path[256];
+
+	snprintf(path, sizeof(path), "%s/%s", root, name);
+
+	return path;
+}
+
+static void Write(const char *name)
+{
+	FILE *f = fopen(Path(name), "w");
+
+	if (f == NULL)
+	{
+		printf("%s: could not be created\n", name);
+		failures++;
+		return;
+	}
+	fprintf(f, "/* %s */\n", name);
+	fclose(f);
+}
+
+// Moves the modification time of a directory forward, changes within one tick would not be noticed
+static void Touch(const char *name)
+{
+	static time_t seconds = 0;
+	struct timespec times[2];
+	struct stat st;
+
+	stat(Path(name), &st);
+	if (seconds <= st.st_mtime)
+		seconds = st.st_mtime;
+	seconds += 10;
+	times[0].tv_sec = times[1].tv_sec = seconds;
+	times[0].tv_nsec = times[1].tv_nsec = 0;
+	utimensat(AT_FDCWD, Path(name), times, 0);
+}
+
+// Expects filename to resolve to the file named at, NULL if it must not resolve
+static void Expect(cparserpaths_t *p, const char *step, const char *filename, const char *at)
+{
+	struct stat st;
+	struct stat sa;
+	bool found = PathsStatFile(p, _T filename, &st);
+
+	if (found != (at != NULL))
+	{
+		printf("%s: %s %s\n", step, filename, found ? "found" : "not found");
+		failures++;
+		return;
+	}
+	if (found && ((stat(Path(at), &sa) != 0) || (sa.st_ino != st.st_ino) || (sa.st_dev != st.st_dev)))
+	{
+		printf("%s: %s not resolved to %s\n", step, filename, at);
+		failures++;
+	}
+}
+
+static void TestPaths(void)
+{
+	cparserpaths_t *p = PathsNew();
+	cparserpaths_t *c;
+	FILE *f;
+
+	mkdir(Path("a"), 0700);
+	mkdir(Path("a/sub"), 0700);
+	mkdir(Path("b"), 0700);
+	Write("a/both.h");
+	Write("a/sub/nested.h");
+	Write("b/both.h");
+	Write("b/plain.h");
+	PathsAddIndexedPath(p, _T Path("a"));
+	PathsAddPath(p, _T Path("b"));
+
+	// Search paths are tried in order, indexed ones only if the index has the file
+	Expect(p, "order", "both.h", "a/both.h");
+	Expect(p, "order", "plain.h", "b/plain.h");
+	Expect(p, "order", "sub/nested.h", "a/sub/nested.h");
+	Expect(p, "order", "sub/plain.h", NULL);
+	Expect(p, "order", "missing.h", NULL);
+	f = PathsOpenFile(p, _T "plain.h", _T "rb");
+	if (f == NULL)
+	{
+		printf("open: plain.h not opened\n");
+		failures++;
+	}
+	else
+		fclose(f);
+
+	// Cached resolutions, missing ones included, hold until the search paths are refreshed
+	Write("a/missing.h");
+	Touch("a");
+	Expect(p, "cached", "missing.h", NULL);
+	PathsRefresh(p);
+	Expect(p, "refresh", "missing.h", "a/missing.h");
+
+	// Indexed directories are checked once per refresh
+	Write("a/late.h");
+	Touch("a");
+	Expect(p, "checked", "late.h", NULL);
+	c = PathsClone(p);
+	Expect(c, "clone", "late.h", "a/late.h");
+	Expect(c, "clone", "both.h", "a/both.h");
+
+	// Cached resolutions to files gone are resolved again
+	unlink(Path("a/both.h"));
+	Expect(p, "gone", "both.h", "b/both.h");
+	Expect(c, "gone", "both.h", "b/both.h");
+
+	// Search paths changes resolve again
+	PathsDeletePathByIndex(c, 0);
+	Expect(c, "deleted", "late.h", NULL);
+	Expect(c, "deleted", "plain.h", "b/plain.h");
+	PathsAddIndexedPath(c, _T Path("a"));
+	Expect(c, "added", "late.h", "a/late.h");
+	Expect(c, "added", "both.h", "b/both.h");
+
+	// Indexes are shared, a directory rescanned for one search paths object is seen by all
+	Expect(p, "shared", "late.h", "a/late.h");
+
+	PathsDelete(c);
+	PathsDelete(p);
+
+	unlink(Path("a/late.h"));
+	unlink(Path("a/missing.h"));
+	unlink(Path("a/sub/nested.h"));
+	unlink(Path("b/both.h"));
+	unlink(Path("b/plain.h"));
+	rmdir(Path("a/sub"));
+	rmdir(Path("a"));
+	rmdir(Path("b"));
+}
+
+int main()
+{
+	if (mkdtemp(root) == NULL)
+	{
+		printf("temporary directory could not be created\n");
+		return 1;
+	}
+
+	TestPaths();
+	rmdir(root);
+
+	return (failures == 0) ? 0 : 1;
+}
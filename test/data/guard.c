@@ -0,0 +1,12 @@
+#include <guard_ifndef.h>
+#include <guard_ifndef.h>
+#include <guard_if_defined.h>
+#include <guard_if_defined.h>
+#include <guard_if_defined_bare.h>
+#include <guard_if_defined_bare.h>
+#include <guard_condition.h>
+#include <guard_condition.h>
+#include <guard_else.h>
+#include <guard_else.h>
+
+int guard;
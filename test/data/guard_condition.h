@@ -0,0 +1,8 @@
+/*
+ * Not guarded, its condition tests something else too
+ */
+
+#if !defined(GUARD_CONDITION_H_) && 1
+#define GUARD_CONDITION_H_
+
+#endif
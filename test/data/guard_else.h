@@ -0,0 +1,9 @@
+/*
+ * Not guarded, it has contents in its #else branch
+ */
+
+#ifndef GUARD_ELSE_H_
+#define GUARD_ELSE_H_
+#else
+#define GUARD_ELSE_AGAIN 1
+#endif
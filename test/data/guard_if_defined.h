@@ -0,0 +1,10 @@
+/*
+ * Guarded by #if !defined(X)
+ */
+
+#if !defined(GUARD_IF_DEFINED_H_)
+#define GUARD_IF_DEFINED_H_
+
+#define GUARD_IF_DEFINED 1
+
+#endif
@@ -0,0 +1,10 @@
+/*
+ * Guarded by #if !defined X
+ */
+
+#if !defined GUARD_IF_DEFINED_BARE_H_
+#define GUARD_IF_DEFINED_BARE_H_
+
+#define GUARD_IF_DEFINED_BARE 1
+
+#endif
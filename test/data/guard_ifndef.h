@@ -0,0 +1,10 @@
+/*
+ * Guarded by #ifndef
+ */
+
+#ifndef GUARD_IFNDEF_H_
+#define GUARD_IFNDEF_H_
+
+#define GUARD_IFNDEF 1
+
+#endif /* GUARD_IFNDEF_H_ */
@@ -0,0 +1,32 @@
+#!/bin/sh
+#
+# Builds and runs every test/*_test.c against the parser sources
+#
+# Usage: test/run.sh [compiler flags]
+#
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=${TMPDIR:-/tmp}/cparser_test
+CC=${CC:-gcc}
+FAILED=0
+
+mkdir -p "$OUT"
+
+for TEST in "$ROOT"/test/*_test.c
+do
+	NAME=$(basename "$TEST" .c)
+
+	if ! $CC -std=gnu11 -Wall -I"$ROOT/src/cparser" "$@" "$TEST" "$ROOT"/src/cparser/*.c -o "$OUT/$NAME" -lpthread
+	then
+		echo "$NAME: build failed"
+		FAILED=1
+	elif ! (cd "$ROOT/test" && "$OUT/$NAME")
+	then
+		echo "$NAME: failed"
+		FAILED=1
+	else
+		echo "$NAME: passed"
+	fi
+done
+
+exit $FAILED